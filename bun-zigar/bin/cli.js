@@ -6,8 +6,8 @@ import { buildAddon, optionsForAddon } from 'node-zigar-addon';
 import os from 'os';
 import { dirname, extname, join, parse, relative, resolve } from 'path';
 import {
-  compile, findConfigFile, generateCode, getArch, getPlatform, hideStatus, optionsForCompile,
-  processConfig, showResult, showStatus, test,
+  compile, findConfigFile, generateCode, getArch, getArtifactCacheStats, getPlatform, hideStatus,
+  optionsForCompile, processConfig, showResult, showStatus, test,
 } from 'zigar-compiler';
 
 const require = createRequire(import.meta.url);
@@ -105,6 +105,12 @@ async function buildModules() {
       parentDirs.push(parentDir);
     }
   }
+  if (compileOptions.artifactCacheDir) {
+    const { hits, misses, errors } = getArtifactCacheStats();
+    let summary = `Artifact cache: ${hits} hit(s), ${misses} miss(es)`;
+    if (errors > 0) summary += `, ${errors} error(s)`;
+    showResult(summary);
+  }
   const nativeAddonPaths = {};
   for (const parentDir of parentDirs) {
     const addonDir = join(parentDir, 'node-zigar-addon');
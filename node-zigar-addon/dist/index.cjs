@@ -22,6 +22,11 @@ function getGCStatistics() {
   return getGCStatistics();
 }
 
+function getCallQueueStatistics() {
+  const { getCallQueueStatistics } = loadAddon();
+  return getCallQueueStatistics();
+}
+
 function getLibraryPath() {
   return __filename;
 }
@@ -153,6 +158,7 @@ module.exports = {
   createEnvironment,
   importModule,
   getGCStatistics,
+  getCallQueueStatistics,
   getLibraryPath,
   buildAddon,
   optionsForAddon,
@@ -13,6 +13,7 @@ const Env = napi.Env;
 const Value = napi.Value;
 const Ref = napi.Ref;
 const ThreadsafeFunction = napi.ThreadsafeFunction;
+const CallQueue = @import("call-queue.zig").CallQueue;
 const redirection = @import("redirection.zig");
 const fn_transform = @import("zigft/fn-transform.zig");
 
@@ -111,10 +112,10 @@ const ModuleHost = struct {
     } = .{},
     ts: struct {
         disable_multithread: ?ThreadsafeFunction = null,
-        handle_jscall: ?ThreadsafeFunction = null,
-        handle_syscall: ?ThreadsafeFunction = null,
         release_function: ?ThreadsafeFunction = null,
+        process_call_queue: ?ThreadsafeFunction = null,
     } = .{},
+    call_queue: CallQueue(PendingCall, 256) = .{},
 
     pub threadlocal var trapping_syscalls: bool = false;
     pub threadlocal var main_thread_syscall_trap_count: usize = 0;
@@ -128,6 +129,10 @@ const ModuleHost = struct {
     var function_count: i32 = 0;
 
     const Module = interface.Module(Value);
+    const PendingCall = union(enum) {
+        jscall: *Jscall,
+        syscall: *Syscall,
+    };
 
     fn register(self: *@This()) !void {
         host_list_mutex.lock();
@@ -147,7 +152,7 @@ const ModuleHost = struct {
     }
 
     fn attachExports(env: Env, exports: Value) !void {
-        inline for (.{ "createEnvironment", "getGCStatistics" }) |name| {
+        inline for (.{ "createEnvironment", "getGCStatistics", "getCallQueueStatistics" }) |name| {
             const func = @field(@This(), name);
             try env.setNamedProperty(exports, name, try env.createCallback(name, func, false, null));
         }
@@ -197,6 +202,39 @@ const ModuleHost = struct {
         return stats;
     }
 
+    fn getCallQueueStatistics(env: Env) !Value {
+        var depth: usize = 0;
+        var max_depth: usize = 0;
+        var items: usize = 0;
+        var overflows: usize = 0;
+        var wakeups: usize = 0;
+        var batches: usize = 0;
+        var max_batch_size: usize = 0;
+        {
+            host_list_mutex.lock();
+            defer host_list_mutex.unlock();
+            for (host_list.items) |host| {
+                const queue = &host.call_queue;
+                depth += queue.getDepth();
+                max_depth = @max(max_depth, queue.stats.max_depth.load(.monotonic));
+                items += queue.stats.items.load(.monotonic);
+                overflows += queue.stats.overflows.load(.monotonic);
+                wakeups += queue.stats.wakeups.load(.monotonic);
+                batches += queue.stats.batches;
+                max_batch_size = @max(max_batch_size, queue.stats.max_batch_size);
+            }
+        }
+        const stats = try env.createObject();
+        try env.setNamedProperty(stats, "depth", try env.createUsize(depth));
+        try env.setNamedProperty(stats, "maxDepth", try env.createUsize(max_depth));
+        try env.setNamedProperty(stats, "calls", try env.createUsize(items));
+        try env.setNamedProperty(stats, "overflows", try env.createUsize(overflows));
+        try env.setNamedProperty(stats, "wakeups", try env.createUsize(wakeups));
+        try env.setNamedProperty(stats, "batches", try env.createUsize(batches));
+        try env.setNamedProperty(stats, "maxBatchSize", try env.createUsize(max_batch_size));
+        return stats;
+    }
+
     fn compileJavaScript(env: Env) !Value {
         const js_file_name = switch (@bitSizeOf(usize)) {
             64 => "dist/addon.64b.js.zst",
@@ -1032,10 +1070,9 @@ const ModuleHost = struct {
             const status_value = try env.getValueUint32(status);
             return std.meta.intToEnum(E, status_value) catch .FAULT;
         } else {
-            const func = self.ts.handle_jscall orelse return error.Disabled;
             var futex: Futex = undefined;
             call.futex_handle = futex.init();
-            try napi.callThreadsafeFunction(func, @constCast(call), .nonblocking);
+            try self.queueCall(.{ .jscall = call });
             return futex.wait();
         }
     }
@@ -1087,16 +1124,16 @@ const ModuleHost = struct {
                 .write_stderr => try self.handleWriteStderr(futex, &call.u.write_stderr),
             };
         } else {
-            const func = self.ts.handle_syscall orelse return error.Disabled;
             var futex: Futex = undefined;
             call.futex_handle = futex.init();
             if (call.cmd == .write and call.u.write.fd == 2) {
                 const len: usize = call.u.write.len;
                 const bytes = call.u.write.bytes;
-                const new_call = try c_allocator.create(Syscall);
-                errdefer c_allocator.destroy(new_call);
-                const new_bytes = try c_allocator.alloc(u8, len);
-                errdefer c_allocator.free(new_bytes);
+                // the struct and a copy of the bytes go into a single allocation
+                const block = try c_allocator.alignedAlloc(u8, .of(Syscall), @sizeOf(Syscall) + len);
+                errdefer c_allocator.free(block);
+                const new_call: *Syscall = @ptrCast(block.ptr);
+                const new_bytes = block[@sizeOf(Syscall)..];
                 @memcpy(new_bytes, bytes[0..len]);
                 new_call.* = .{
                     .cmd = .write_stderr,
@@ -1106,16 +1143,64 @@ const ModuleHost = struct {
                     } },
                     .futex_handle = 0,
                 };
-                try napi.callThreadsafeFunction(func, new_call, .nonblocking);
+                try self.queueCall(.{ .syscall = new_call });
                 call.u.write.written = call.u.write.len;
                 futex.timeout = 50000;
             } else {
-                try napi.callThreadsafeFunction(func, call, .nonblocking);
+                try self.queueCall(.{ .syscall = call });
             }
             return futex.wait();
         }
     }
 
+    fn queueCall(self: *@This(), call: PendingCall) !void {
+        if (!self.call_queue.enter()) return error.Disabled;
+        defer self.call_queue.leave();
+        const func = self.ts.process_call_queue orelse return error.Disabled;
+        // wait for room instead of handing the call over separately, which would let it overtake
+        // calls that are already queued
+        while (!self.call_queue.push(call)) {
+            if (self.call_queue.isClosed()) return error.Disabled;
+            std.Thread.yield() catch {};
+        }
+        // nothing past this point can fail, since the call is in the queue; if the main thread
+        // can't be woken now, the call gets handled on the next wake-up or rejected when the
+        // queue is closed
+        if (self.call_queue.claimWakeup()) {
+            napi.callThreadsafeFunction(func, null, .nonblocking) catch self.call_queue.beginBatch();
+        }
+    }
+
+    fn processCallQueue(self: *@This()) void {
+        self.call_queue.beginBatch();
+        var count: usize = 0;
+        while (self.call_queue.pop()) |call| : (count += 1) {
+            switch (call) {
+                .jscall => |jscall| _ = self.handleJscall(jscall) catch {
+                    // wake caller if call fails since JavaScript isn't going to do it
+                    Futex.wake(jscall.futex_handle, .FAULT) catch {};
+                },
+                .syscall => |syscall| _ = self.handleSyscall(syscall) catch {
+                    Futex.wake(syscall.futex_handle, .FAULT) catch {};
+                },
+            }
+        }
+        self.call_queue.endBatch(count);
+    }
+
+    fn rejectPendingCalls(self: *@This()) void {
+        while (self.call_queue.pop()) |call| {
+            switch (call) {
+                .jscall => |jscall| Futex.wake(jscall.futex_handle, .FAULT) catch {},
+                .syscall => |syscall| switch (syscall.cmd) {
+                    // nobody is waiting for this one
+                    .write_stderr => freeWriteStderr(syscall),
+                    else => Futex.wake(syscall.futex_handle, .FAULT) catch {},
+                },
+            }
+        }
+    }
+
     fn callPosixFunction(self: *@This(), fn_ref: ?Ref, args: []const Value) !E {
         const env = self.env;
         const result = try env.callFunction(
@@ -1211,16 +1296,19 @@ const ModuleHost = struct {
         });
     }
 
+    fn freeWriteStderr(call: *Syscall) void {
+        // free the struct along with the bytes following it
+        const block: [*]align(@alignOf(Syscall)) u8 = @ptrCast(call);
+        c_allocator.free(block[0 .. @sizeOf(Syscall) + call.u.write_stderr.len]);
+    }
+
     fn handleWriteStderr(self: *@This(), futex: Value, args: anytype) !E {
         const env = self.env;
         const len: usize = args.len;
         const bytes = args.bytes;
         defer {
-            // free the buffer and the struct
             const u_ptr: *@FieldType(Syscall, "u") = @ptrCast(@alignCast(args));
-            const call: *Syscall = @fieldParentPtr("u", u_ptr);
-            c_allocator.free(bytes[0..len]);
-            c_allocator.destroy(call);
+            freeWriteStderr(@fieldParentPtr("u", u_ptr));
         }
         const opaque_ptr, const buffer = try env.createArraybuffer(len);
         const dest: [*]u8 = @ptrCast(opaque_ptr);
@@ -1601,6 +1689,8 @@ const ModuleHost = struct {
             const prev_count = self.multithread_count.fetchAdd(1, .monotonic);
             errdefer _ = self.multithread_count.fetchSub(1, .monotonic);
             if (prev_count == 0) {
+                // fail anything left behind from a previous session
+                self.rejectPendingCalls();
                 const env = self.env;
                 const fields = @typeInfo(@FieldType(ModuleHost, "ts")).@"struct".fields;
                 const resource_name = try env.createStringUtf8("zigar");
@@ -1608,6 +1698,7 @@ const ModuleHost = struct {
                     const cb = @field(threadsafe_callback, field.name);
                     @field(self.ts, field.name) = try env.createThreadsafeFunction(null, null, resource_name, 0, 1, null, null, @ptrCast(self), @ptrCast(&cb));
                 }
+                self.call_queue.open();
             }
         } else {
             return error.Unsupported;
@@ -1619,6 +1710,9 @@ const ModuleHost = struct {
             const prev_count = self.multithread_count.fetchSub(1, .monotonic);
             errdefer _ = self.multithread_count.fetchAdd(1, .monotonic);
             if (prev_count == 1) {
+                // calls queued after this would never get processed
+                self.call_queue.close();
+                self.rejectPendingCalls();
                 const fields = @typeInfo(@FieldType(ModuleHost, "ts")).@"struct".fields;
                 inline for (fields) |field| {
                     if (@field(self.ts, field.name)) |ref|
@@ -1633,29 +1727,17 @@ const ModuleHost = struct {
     }
 
     const threadsafe_callback = struct {
-        fn handle_jscall(_: *Env, _: Value, context: *anyopaque, data: *anyopaque) callconv(.c) void {
-            const self: *ModuleHost = @ptrCast(@alignCast(context));
-            const call: *Jscall = @ptrCast(@alignCast(data));
-            _ = handleJscall(self, call) catch {
-                // wake caller if call fails since JavaScript isn't going to do it
-                Futex.wake(call.futex_handle, .FAULT) catch {};
-            };
-        }
-
-        fn handle_syscall(_: *Env, _: Value, context: *anyopaque, data: *anyopaque) callconv(.c) void {
-            const self: *ModuleHost = @ptrCast(@alignCast(context));
-            const call: *Syscall = @ptrCast(@alignCast(data));
-            _ = handleSyscall(self, call) catch {
-                Futex.wake(call.futex_handle, .FAULT) catch {};
-            };
-        }
-
         fn release_function(_: *Env, _: Value, context: *anyopaque, data: *anyopaque) callconv(.c) void {
             const self: *ModuleHost = @ptrCast(@alignCast(context));
             const fn_id = @intFromPtr(data);
             releaseFunction(self, fn_id) catch {};
         }
 
+        fn process_call_queue(_: *Env, _: Value, context: *anyopaque, _: *anyopaque) callconv(.c) void {
+            const self: *ModuleHost = @ptrCast(@alignCast(context));
+            processCallQueue(self);
+        }
+
         fn disable_multithread(_: *Env, _: Value, context: *anyopaque, _: *anyopaque) callconv(.c) void {
             const self: *ModuleHost = @ptrCast(@alignCast(context));
             disableMultithread(self) catch {};
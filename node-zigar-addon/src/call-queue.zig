@@ -0,0 +1,201 @@
+const std = @import("std");
+
+/// Bounded multi-producer, single-consumer ring buffer. Worker threads push pending calls into
+/// it while the main thread drains everything that's queued in one go.
+pub fn CallQueue(comptime T: type, comptime capacity: usize) type {
+    if (!std.math.isPowerOfTwo(capacity)) @compileError("Capacity must be a power of two");
+    return struct {
+        slots: [capacity]Slot = init: {
+            var slots: [capacity]Slot = undefined;
+            for (&slots, 0..) |*slot, index| slot.sequence = .init(index);
+            break :init slots;
+        },
+        head: std.atomic.Value(usize) = .init(0),
+        tail: std.atomic.Value(usize) = .init(0),
+        scheduled: std.atomic.Value(bool) = .init(false),
+        closed: std.atomic.Value(bool) = .init(true),
+        producers: std.atomic.Value(usize) = .init(0),
+        stats: Stats = .{},
+
+        const Slot = struct {
+            sequence: std.atomic.Value(usize),
+            item: T,
+        };
+        pub const Stats = struct {
+            items: std.atomic.Value(usize) = .init(0),
+            overflows: std.atomic.Value(usize) = .init(0),
+            wakeups: std.atomic.Value(usize) = .init(0),
+            max_depth: std.atomic.Value(usize) = .init(0),
+            // only updated by the consumer
+            batches: usize = 0,
+            max_batch_size: usize = 0,
+        };
+
+        pub fn init(self: *@This()) void {
+            self.* = .{};
+        }
+
+        /// Register a producer, returning false when the queue is closed; items can only be pushed
+        /// between calls to enter() and leave()
+        pub fn enter(self: *@This()) bool {
+            _ = self.producers.fetchAdd(1, .seq_cst);
+            if (self.closed.load(.seq_cst)) {
+                self.leave();
+                return false;
+            }
+            return true;
+        }
+
+        pub fn leave(self: *@This()) void {
+            _ = self.producers.fetchSub(1, .seq_cst);
+        }
+
+        pub fn open(self: *@This()) void {
+            self.closed.store(false, .seq_cst);
+        }
+
+        /// Stop accepting items and wait for producers that are in the middle of pushing; items
+        /// still in the queue afterward have to be popped by the consumer
+        pub fn close(self: *@This()) void {
+            self.closed.store(true, .seq_cst);
+            while (self.producers.load(.seq_cst) != 0) std.Thread.yield() catch {};
+        }
+
+        pub fn isClosed(self: *const @This()) bool {
+            return self.closed.load(.seq_cst);
+        }
+
+        /// Add an item to the queue, returning false when the queue is full
+        pub fn push(self: *@This(), item: T) bool {
+            var pos = self.head.load(.monotonic);
+            while (true) {
+                const slot = &self.slots[pos & (capacity - 1)];
+                const seq = slot.sequence.load(.acquire);
+                const diff: isize = @bitCast(seq -% pos);
+                if (diff == 0) {
+                    if (self.head.cmpxchgWeak(pos, pos +% 1, .monotonic, .monotonic)) |actual| {
+                        pos = actual;
+                    } else {
+                        slot.item = item;
+                        slot.sequence.store(pos +% 1, .release);
+                        _ = self.stats.items.fetchAdd(1, .monotonic);
+                        const depth = pos +% 1 -% self.tail.load(.monotonic);
+                        _ = self.stats.max_depth.fetchMax(depth, .monotonic);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    _ = self.stats.overflows.fetchAdd(1, .monotonic);
+                    return false;
+                } else {
+                    pos = self.head.load(.monotonic);
+                }
+            }
+        }
+
+        /// Remove an item from the queue; must only be called by the consumer
+        pub fn pop(self: *@This()) ?T {
+            const pos = self.tail.load(.monotonic);
+            const slot = &self.slots[pos & (capacity - 1)];
+            const seq = slot.sequence.load(.acquire);
+            if (seq != pos +% 1) return null;
+            const item = slot.item;
+            slot.sequence.store(pos +% capacity, .release);
+            self.tail.store(pos +% 1, .monotonic);
+            return item;
+        }
+
+        /// Return true if the caller is responsible for waking the consumer
+        pub fn claimWakeup(self: *@This()) bool {
+            if (self.scheduled.swap(true, .acq_rel)) return false;
+            _ = self.stats.wakeups.fetchAdd(1, .monotonic);
+            return true;
+        }
+
+        /// Called by the consumer prior to draining the queue, so that items pushed while it's
+        /// working would trigger another wake-up
+        pub fn beginBatch(self: *@This()) void {
+            self.scheduled.store(false, .release);
+        }
+
+        pub fn endBatch(self: *@This(), count: usize) void {
+            if (count == 0) return;
+            self.stats.batches += 1;
+            if (count > self.stats.max_batch_size) self.stats.max_batch_size = count;
+        }
+
+        pub fn getDepth(self: *const @This()) usize {
+            return self.head.load(.monotonic) -% self.tail.load(.monotonic);
+        }
+    };
+}
+
+test "CallQueue push and pop" {
+    var queue: CallQueue(usize, 4) = undefined;
+    queue.init();
+    try std.testing.expect(queue.push(1));
+    try std.testing.expect(queue.push(2));
+    try std.testing.expectEqual(2, queue.getDepth());
+    try std.testing.expectEqual(1, queue.pop());
+    try std.testing.expectEqual(2, queue.pop());
+    try std.testing.expectEqual(null, queue.pop());
+}
+
+test "CallQueue overflow" {
+    var queue: CallQueue(usize, 4) = undefined;
+    queue.init();
+    for (0..4) |i| try std.testing.expect(queue.push(i));
+    try std.testing.expect(!queue.push(4));
+    try std.testing.expectEqual(1, queue.stats.overflows.load(.monotonic));
+    try std.testing.expectEqual(0, queue.pop());
+    try std.testing.expect(queue.push(4));
+}
+
+test "CallQueue wake-up" {
+    var queue: CallQueue(usize, 4) = undefined;
+    queue.init();
+    try std.testing.expect(queue.claimWakeup());
+    try std.testing.expect(!queue.claimWakeup());
+    queue.beginBatch();
+    try std.testing.expect(queue.claimWakeup());
+}
+
+test "CallQueue open and close" {
+    var queue: CallQueue(usize, 4) = .{};
+    try std.testing.expect(!queue.enter());
+    queue.open();
+    try std.testing.expect(queue.enter());
+    try std.testing.expect(queue.push(1));
+    queue.leave();
+    queue.close();
+    try std.testing.expect(!queue.enter());
+    try std.testing.expectEqual(1, queue.pop());
+}
+
+test "CallQueue multiple producers" {
+    const Queue = CallQueue(usize, 1024);
+    var queue: Queue = undefined;
+    queue.init();
+    const producer_count = 8;
+    const per_producer = 100;
+    const ns = struct {
+        fn produce(q: *Queue, base: usize) void {
+            for (0..per_producer) |i| {
+                while (!q.push(base + i)) std.Thread.yield() catch {};
+            }
+        }
+    };
+    var threads: [producer_count]std.Thread = undefined;
+    for (&threads, 0..) |*thread, index| {
+        thread.* = try std.Thread.spawn(.{}, ns.produce, .{ &queue, index * per_producer });
+    }
+    var seen: [producer_count * per_producer]bool = @splat(false);
+    var received: usize = 0;
+    while (received < seen.len) {
+        if (queue.pop()) |value| {
+            try std.testing.expect(!seen[value]);
+            seen[value] = true;
+            received += 1;
+        }
+    }
+    for (threads) |thread| thread.join();
+}
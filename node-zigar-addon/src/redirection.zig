@@ -14,9 +14,10 @@ const os = switch (builtin.target.os.tag) {
     else => .unknown,
 };
 
+pub const LibExtent = struct { address: usize = 0, len: usize = 0 };
+
 pub fn Controller(comptime Host: type) type {
     const bits = @bitSizeOf(usize);
-    const LibExtent = struct { address: usize = 0, len: usize = 0 };
     const syscall_user_dispatch = os == .linux and builtin.target.cpu.arch.isX86();
 
     return struct {
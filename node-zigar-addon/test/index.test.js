@@ -7,6 +7,7 @@ import { createConfig } from '../../zigar-compiler/src/compilation.js';
 
 import {
   buildAddon,
+  getCallQueueStatistics,
   getGCStatistics,
   getLibraryPath,
   importModule,
@@ -98,6 +99,15 @@ describe('Addon functionalities', function() {
         expect(stats).to.be.an('object');
       })
     })
+    describe('getCallQueueStatistics', function() {
+      it('should get call queue statistics', function() {
+        const stats = getCallQueueStatistics();
+        expect(stats).to.be.an('object');
+        expect(stats.depth).to.be.a('number');
+        expect(stats.batches).to.be.a('number');
+        expect(stats.maxBatchSize).to.be.a('number');
+      })
+    })
     describe('getLibraryPath', function() {
       it('should return path to library', function() {
         const path = getLibraryPath();
@@ -1,11 +1,12 @@
 import { buildAddon, createEnvironment, getLibraryPath, optionsForAddon } from 'node-zigar-addon';
+import { readFile } from 'fs/promises';
 import { dirname, extname, join, parse } from 'path';
 import { cwd } from 'process';
-import { pathToFileURL } from 'url';
+import { fileURLToPath, pathToFileURL } from 'url';
 import {
   compile, extractOptions, findConfigFile, findSourceFile, generateCode, getArch, getCachePath,
-  getModuleCachePath, getPlatform, hideStatus, loadConfigFile, normalizePath, optionsForCompile,
-  showStatus,
+  getModuleCachePath, getPlatform, getSnapshotKey, hideStatus, loadConfigFile, loadStructureSnapshot,
+  normalizePath, optionsForCompile, saveStructureSnapshot, showStatus,
 } from 'zigar-compiler';
 
 const baseURL = pathToFileURL(`${cwd()}/`).href;
@@ -80,18 +81,48 @@ export async function load(url, context, nextLoad) {
   // is absent, compilation does not occur
   const { outputPath } = await compile(srcPath, modPath, compileOptions);
   process.env.ADDON_PATH = addonPath;
-  const env = createEnvironment();
-  env.loadModule(outputPath, false);
-  env.acquireStructures(options);
-  const definition = env.exportStructures();
   // get the absolute path to node-zigar-addon so the transpiled code can find it
   const runtimeURL = pathToFileURL(getLibraryPath()).href;
-  const binarySource = env.hasMethods() ? JSON.stringify(outputPath) : undefined;
   const envVariables = { ADDON_PATH: addonPath };
-  const { code } = generateCode(definition, { runtimeURL, binarySource, envVariables });
+  // reuse code generated earlier when the library hasn't changed, so that we don't need to
+  // run the library's factory function just to learn what it exports
+  const useSnapshot = options.structureSnapshot !== false;
+  const snapshotKey = (useSnapshot) ? await getSnapshotKey(outputPath, {
+    outputPath, runtimeURL, envVariables, versions: await getPackageVersions(),
+  }) : null;
+  let code = (useSnapshot) ? await loadStructureSnapshot(outputPath, snapshotKey) : null;
+  if (!code) {
+    const env = createEnvironment();
+    env.loadModule(outputPath, false);
+    env.acquireStructures(options);
+    const definition = env.exportStructures();
+    const binarySource = env.hasMethods() ? JSON.stringify(outputPath) : undefined;
+    ({ code } = generateCode(definition, { runtimeURL, binarySource, envVariables }));
+    if (useSnapshot) {
+      await saveStructureSnapshot(outputPath, snapshotKey, code);
+    }
+  }
   return {
     format: 'module',
     shortCircuit: true,
     source: code,
   };
 }
+
+let packageVersions;
+
+async function getPackageVersions() {
+  // generated code depends on the compiler that produced it and on the runtime it's linked to,
+  // whose code is bundled into node-zigar-addon
+  if (!packageVersions) {
+    const readVersion = async (entryPath) => {
+      const pkgPath = join(dirname(entryPath), '../package.json');
+      return JSON.parse(await readFile(pkgPath, 'utf-8')).version;
+    };
+    packageVersions = {
+      compiler: await readVersion(fileURLToPath(import.meta.resolve('zigar-compiler'))),
+      runtime: await readVersion(getLibraryPath()),
+    };
+  }
+  return packageVersions;
+}
@@ -360,6 +360,26 @@ pub const Any = union(enum) {
         }
     }
 
+    pub fn setElements(self: @This(), source: anytype, values: php.PackedValues) !bool {
+        @setEvalBranchQuota(2000000);
+        switch (self) {
+            inline else => |acc| {
+                if (comptime !@hasDecl(@TypeOf(acc), "setElements")) return false;
+                return try acc.setElements(source.buffer, values);
+            },
+        }
+    }
+
+    pub fn getElements(self: @This(), source: anytype, len: usize) !?Value {
+        @setEvalBranchQuota(2000000);
+        switch (self) {
+            inline else => |acc| {
+                if (comptime !@hasDecl(@TypeOf(acc), "getElements")) return null;
+                return try acc.getElements(source.buffer, len);
+            },
+        }
+    }
+
     pub fn isType(self: @This(), comptime accessor_type: Type) bool {
         @setEvalBranchQuota(2000000);
         return switch (self) {
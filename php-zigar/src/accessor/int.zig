@@ -104,7 +104,7 @@ pub fn Int(comptime attrs: Attributes) type {
     };
 }
 
-fn check(comptime T: type, value: Long) error{FailureReported}!void {
+pub fn check(comptime T: type, value: Long) error{FailureReported}!void {
     if (value < std.math.minInt(T) or value > std.math.maxInt(T)) {
         return failure.report("{s} cannot represent the value given: {d}", .{ @typeName(T), value });
     }
@@ -3,7 +3,10 @@ const std = @import("std");
 const accessor = @import("../accessor.zig");
 const ByteBuffer = @import("../buffer.zig").ByteBuffer;
 const Error = @import("../failure.zig").Error;
+const float = @import("float.zig");
+const int = @import("int.zig");
 const php = @import("../php.zig");
+const Ulong = php.Ulong;
 const Value = php.Value;
 
 fn Arg(comptime func: anytype) type {
@@ -32,6 +35,21 @@ const Attributes = union(enum) {
         return if (is_packed) @bitSizeOf(T) else @sizeOf(T) * 8;
     }
 
+    /// Return the element type when elements can be converted in bulk to and from longs/doubles
+    pub fn Bulk(comptime self: @This()) ?type {
+        return switch (self) {
+            .int => |a| switch (a.bit_size) {
+                8, 16, 32, 64 => a.Type(),
+                else => null,
+            },
+            .float => |a| switch (a.bit_size) {
+                16, 32, 64 => a.Type(),
+                else => null,
+            },
+            else => null,
+        };
+    }
+
     pub fn Primitive(comptime self: @This(), comptime use_bit_offset: bool) type {
         const p_attrs = switch (self) {
             inline else => |a| add: {
@@ -94,6 +112,62 @@ pub fn Vector(comptime attrs: Attributes) type {
                 }
             }
 
+            /// Copy elements from a PHP list in one loop, returning false when an element is not a
+            /// long or a double so the caller can fall back to setElement()
+            pub fn setElements(self: @This(), buffer: *ByteBuffer, values: php.PackedValues) Error!bool {
+                const BT = comptime attrs.Bulk();
+                if (BT == null) return false;
+                const T = BT.?;
+                if (buffer.flags.contains_packed_data) return false;
+                const bytes = try buffer.data(values.len * @sizeOf(T), true);
+                const dest: [*]align(1) T = @ptrCast(bytes.ptr);
+                for (0..values.len) |i| {
+                    const value = values.at(i);
+                    switch (@typeInfo(T)) {
+                        .int => |info| {
+                            if (php.getValueType(value) != .long) return false;
+                            const number = value.value.lval;
+                            if (self.runtime_check) try int.check(T, number);
+                            dest[i] = switch (info.signedness) {
+                                .signed => @truncate(number),
+                                .unsigned => @truncate(@as(Ulong, @bitCast(number))),
+                            };
+                        },
+                        .float => {
+                            const double = switch (php.getValueType(value)) {
+                                .double => value.value.dval,
+                                .long => php.longToDouble(value.value.lval) catch return false,
+                                else => return false,
+                            };
+                            if (self.runtime_check) try float.check(T, double);
+                            dest[i] = @floatCast(double);
+                        },
+                        else => unreachable,
+                    }
+                }
+                return true;
+            }
+
+            /// Copy elements into a new packed PHP array in one loop, returning null when the
+            /// element type does not permit that
+            pub fn getElements(_: @This(), buffer: *ByteBuffer, len: usize) Error!?Value {
+                const BT = comptime attrs.Bulk();
+                if (BT == null) return null;
+                const T = BT.?;
+                if (buffer.flags.contains_packed_data) return null;
+                const bytes = try buffer.data(len * @sizeOf(T), false);
+                const src: [*]align(1) const T = @ptrCast(bytes.ptr);
+                const ht, const values = try php.createPackedArray(len);
+                for (0..len) |i| {
+                    values.at(i).* = switch (@typeInfo(T)) {
+                        .int => php.createValueAnyInt(src[i]),
+                        .float => php.createValueDouble(@floatCast(src[i])),
+                        else => unreachable,
+                    };
+                }
+                return php.createValueArray(ht);
+            }
+
             fn primitiveAt(self: @This(), byte_offset: usize, comptime use_bit_offset: bool) attrs.Primitive(use_bit_offset) {
                 const P = attrs.Primitive(use_bit_offset);
                 var acc: P = undefined;
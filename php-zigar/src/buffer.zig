@@ -22,6 +22,7 @@ pub const ByteBuffer = struct {
         contains_packed_data: bool = false,
         contains_special_contents: bool = false,
         has_allocator: bool = false,
+        shareable: bool = false,
 
         fn assign(self: @This(), flags: anytype) @This() {
             var new = self;
@@ -109,6 +110,28 @@ pub const ByteBuffer = struct {
         }
     }
 
+    pub fn allocateString(self: *@This(), len: usize) void {
+        std.debug.assert(self.flags.uninitialized);
+        defer self.flags.uninitialized = false;
+        // place the bytes inside a zend_string, so they can be given to PHP as is once the buffer
+        // becomes read-only
+        const str = php.createStringWithLength(len);
+        const bytes: [*]u8 = @ptrCast(&str.val[0]);
+        if (len > 0) bytes[len] = 0;
+        self.bytes = bytes[0..len];
+        self.source_type = .string;
+        self.source = .{ .string = str };
+        self.flags.shareable = true;
+    }
+
+    pub fn shrinkString(self: *@This(), len: usize) void {
+        std.debug.assert(self.flags.shareable and len <= self.bytes.len);
+        const str = self.source.string;
+        self.bytes.len = len;
+        self.bytes.ptr[len] = 0;
+        str.len = len;
+    }
+
     pub fn referenceString(self: *@This(), str: *String, read_only: bool) void {
         std.debug.assert(self.flags.uninitialized);
         defer self.flags.uninitialized = false;
@@ -136,7 +159,7 @@ pub const ByteBuffer = struct {
         self.bytes = @constCast(bytes);
         if (parent) |p_buf| {
             const base = p_buf.getBase();
-            self.flags = base.flags.assign(.{ .has_allocator = false, .read_only = false, .temporary = false });
+            self.flags = base.flags.assign(.{ .has_allocator = false, .read_only = false, .temporary = false, .shareable = false });
             if (base.source_type != .none) {
                 self.source_type = .buffer;
                 self.source = .{ .buffer = base };
@@ -172,7 +195,7 @@ pub const ByteBuffer = struct {
             .bytes = @constCast(slice_bytes),
             .alignment = slice_alignment,
             .bit_offset = slice_bit_offset,
-            .flags = self.flags.assign(.{ .has_allocator = false, .temporary = false }),
+            .flags = self.flags.assign(.{ .has_allocator = false, .temporary = false, .shareable = false }),
         };
         if (src_buf.source_type != .none) {
             new.source_type = .buffer;
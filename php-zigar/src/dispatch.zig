@@ -65,24 +65,31 @@ pub const CallDispatcher = struct {
     env_variable_ptr: *[*:null]?[*:0]const u8 = undefined,
     env_variable_original: *[*:null]?[*:0]const u8 = undefined,
     multithread_count: usize = 0,
-    pipe_ptr: [*]c_int,
+    queue: *TaskQueue,
     release_resources_called: bool = false,
+    detached: bool = false,
 
     pub threadlocal var trapping_syscalls: bool = true;
     pub threadlocal var event_loop: EventLoop(runScheduledTask) = .{};
 
     threadlocal var thread_initialized: bool = false;
     threadlocal var in_main_thread: bool = false;
-    threadlocal var pipes: [2]c_int = undefined;
+    threadlocal var task_queue: TaskQueue = .{};
     threadlocal var total_multithread_count: usize = 0;
 
-    var pipe_list_mutex: std.Thread.Mutex = .{};
-    var pipe_list: std.ArrayList(c_int) = .empty;
+    var wake_fd_list_mutex: std.Thread.Mutex = .{};
+    var wake_fd_list: std.ArrayList(c_int) = .empty;
 
     pub const HookEntry = interface.HookEntry;
     pub const HandlerVTable = interface.HandlerVTable;
 
     const redirection_controller = redirection.Controller(@This());
+
+    // what installHooks() learns about a library that stays loaded between requests
+    pub const HookState = struct {
+        extent: ?redirection.LibExtent = null,
+        env_variable_deferred: HookEntry.Deferred = .{},
+    };
     const CallbackEntry = struct {
         id: usize,
         class: *ZigClassEntry,
@@ -232,6 +239,7 @@ pub const CallDispatcher = struct {
     const ScheduledTask = struct {
         self: *CallDispatcher,
         operation: Operation,
+        next: ?*ScheduledTask = null,
 
         pub const Operation = union(enum) {
             jscall: *Jscall,
@@ -239,6 +247,123 @@ pub const CallDispatcher = struct {
             disable: void,
         };
     };
+    const TaskQueue = struct {
+        // tasks posted by other threads, most recent first
+        head: std.atomic.Value(?*ScheduledTask) = .init(null),
+        // tasks taken from head in the order they were posted; only touched by the main thread
+        pending: ?*ScheduledTask = null,
+        // an eventfd on Linux, where both elements are the same descriptor, a pipe elsewhere
+        fds: [2]c_int = .{ -1, -1 },
+        // set when a wake-up could not be sent, so that the next post tries again
+        signal_lost: std.atomic.Value(bool) = .init(false),
+
+        pub fn open(self: *@This()) !void {
+            if (builtin.target.os.tag == .linux) {
+                const flags = std.os.linux.EFD.NONBLOCK | std.os.linux.EFD.CLOEXEC;
+                const fd = std.posix.eventfd(0, flags) catch return error.UnableToOpenPipes;
+                self.fds = .{ fd, fd };
+            } else if (builtin.target.os.tag == .windows) {
+                var read_handle: c.HANDLE = undefined;
+                var write_handle: c.HANDLE = undefined;
+                var security: c.SECURITY_ATTRIBUTES = .{
+                    .nLength = @sizeOf(c.SECURITY_ATTRIBUTES),
+                    .lpSecurityDescriptor = null,
+                    .bInheritHandle = c.TRUE,
+                };
+                if (c.CreatePipe(&read_handle, &write_handle, &security, 0) != c.TRUE) return error.UnableToOpenPipes;
+                self.fds[0] = c._open_osfhandle(@bitCast(@intFromPtr(read_handle)), c._O_RDONLY);
+                self.fds[1] = c._open_osfhandle(@bitCast(@intFromPtr(write_handle)), c._O_WRONLY);
+            } else {
+                if (c.pipe(&self.fds) != 0) return error.UnableToOpenPipes;
+                // set read end of pipe to non-blocking
+                const flags = c.fcntl(self.fds[0], c.F_GETFL, @as(c_int, 0));
+                _ = c.fcntl(self.fds[0], c.F_SETFL, flags | c.O_NONBLOCK);
+            }
+        }
+
+        pub fn close(self: *@This()) void {
+            _ = c.close(self.fds[0]);
+            if (self.fds[1] != self.fds[0]) _ = c.close(self.fds[1]);
+            self.fds = .{ -1, -1 };
+        }
+
+        pub fn post(self: *@This(), task: *ScheduledTask) void {
+            var head = self.head.load(.monotonic);
+            while (true) {
+                task.next = head;
+                head = self.head.cmpxchgWeak(head, task, .release, .monotonic) orelse break;
+            }
+            // only the thread that finds the queue empty needs to wake the main thread; a wake-up
+            // is pending already otherwise
+            //
+            // the task cannot be taken back once it's linked, since the main thread might be
+            // running it already; a failed wake-up is retried by the next post instead
+            if (head == null or self.signal_lost.swap(false, .acq_rel)) {
+                self.signal() catch self.signal_lost.store(true, .release);
+            }
+        }
+
+        pub fn take(self: *@This()) ?*ScheduledTask {
+            if (self.pending == null) {
+                // grab everything posted so far, reversing the list to restore the posting order
+                var list = self.head.swap(null, .acquire);
+                var ordered: ?*ScheduledTask = null;
+                while (list) |task| {
+                    list = task.next;
+                    task.next = ordered;
+                    ordered = task;
+                }
+                self.pending = ordered;
+            }
+            const task = self.pending orelse return null;
+            self.pending = task.next;
+            return task;
+        }
+
+        pub fn hasPending(self: *@This()) bool {
+            return self.pending != null or self.head.load(.monotonic) != null;
+        }
+
+        pub fn signal(self: *@This()) !void {
+            const fd = self.fds[1];
+            if (builtin.target.os.tag == .linux) {
+                const value: u64 = 1;
+                if (c.write(fd, @ptrCast(&value), @sizeOf(u64)) < 0) return error.Unexpected;
+            } else if (builtin.target.os.tag == .windows) {
+                const handle: c.HANDLE = @ptrFromInt(@as(usize, @bitCast(c._get_osfhandle(fd))));
+                const byte: u8 = 1;
+                var written: c.DWORD = undefined;
+                if (c.WriteFile(handle, &byte, 1, &written, null) == c.FALSE) return error.Unexpected;
+            } else {
+                const byte: u8 = 1;
+                if (c.write(fd, @ptrCast(&byte), 1) < 0) return error.Unexpected;
+            }
+        }
+
+        pub fn clearSignal(self: *@This()) void {
+            const fd = self.fds[0];
+            if (builtin.target.os.tag == .linux) {
+                // reading an eventfd resets its counter
+                var value: u64 = undefined;
+                _ = c.read(fd, @ptrCast(&value), @sizeOf(u64));
+            } else {
+                var buffer: [64]u8 = undefined;
+                while (true) {
+                    var len: usize = buffer.len;
+                    if (builtin.target.os.tag == .windows) {
+                        // reading from an empty pipe would block
+                        const handle: c.HANDLE = @ptrFromInt(@as(usize, @bitCast(c._get_osfhandle(fd))));
+                        var available: c.DWORD = undefined;
+                        if (c.PeekNamedPipe(handle, null, 0, null, &available, null) == c.FALSE) return;
+                        if (available == 0) return;
+                        len = @min(len, available);
+                    }
+                    const read = c.read(fd, &buffer, @intCast(len));
+                    if (read < buffer.len) return;
+                }
+            }
+        }
+    };
     const Futex = struct {
         const initial_value = 0xffff_ffff;
 
@@ -279,20 +404,14 @@ pub const CallDispatcher = struct {
     pub fn init(host: *ModuleHost) !*@This() {
         const self = try php.allocator.create(@This());
         errdefer php.allocator.destroy(self);
-        self.* = .{ .host = host, .pipe_ptr = &pipes };
+        self.* = .{ .host = host, .queue = &task_queue };
         try extension.addRequestShutdownCallback(self, onRequestShutdown);
         return self;
     }
 
     pub fn deinit(self: *@This()) void {
         self.disableMultithread() catch {};
-        if (self.syscall_trap_installed) {
-            if (self.getSyscallHook("__sc_vtable")) |hook| {
-                const vtable: *const HandlerVTable = @ptrCast(@alignCast(hook.handler));
-                redirection_controller.removeSyscallVtable(self, vtable) catch {};
-            }
-            redirection_controller.uninstallSyscallTrap();
-        }
+        self.detach();
         extension.removeRequestShutdownCallback(self, onRequestShutdown);
         self.releaseResources();
         if (self.env_variable_list) |list| c_allocator.free(list);
@@ -305,43 +424,22 @@ pub const CallDispatcher = struct {
         if (!thread_initialized) {
             in_main_thread = true;
             redirection_controller.installSignalHandler() catch {};
-            try createPipes();
-            pipe_list_mutex.lock();
-            defer pipe_list_mutex.unlock();
-            for (pipes) |fd| try pipe_list.append(std.heap.c_allocator, fd);
+            try task_queue.open();
+            wake_fd_list_mutex.lock();
+            defer wake_fd_list_mutex.unlock();
+            try wake_fd_list.append(std.heap.c_allocator, task_queue.fds[0]);
+            if (task_queue.fds[1] != task_queue.fds[0]) {
+                try wake_fd_list.append(std.heap.c_allocator, task_queue.fds[1]);
+            }
         }
     }
 
     pub fn uninstallHandlers() void {
         trapping_syscalls = false;
-        destroyPipes();
+        task_queue.close();
         redirection_controller.uninstallSignalHandler();
     }
 
-    fn createPipes() !void {
-        if (builtin.target.os.tag == .windows) {
-            var read_handle: c.HANDLE = undefined;
-            var write_handle: c.HANDLE = undefined;
-            var security: c.SECURITY_ATTRIBUTES = .{
-                .nLength = @sizeOf(c.SECURITY_ATTRIBUTES),
-                .lpSecurityDescriptor = null,
-                .bInheritHandle = c.TRUE,
-            };
-            if (c.CreatePipe(&read_handle, &write_handle, &security, 0) != c.TRUE) return error.UnableToOpenPipes;
-            pipes[0] = c._open_osfhandle(@bitCast(@intFromPtr(read_handle)), c._O_RDONLY);
-            pipes[1] = c._open_osfhandle(@bitCast(@intFromPtr(write_handle)), c._O_WRONLY);
-        } else {
-            if (c.pipe(&pipes) != 0) return error.UnableToOpenPipes;
-            // set read end of pipe to non-blocking
-            const flags = c.fcntl(pipes[0], c.F_GETFL, @as(c_int, 0));
-            _ = c.fcntl(pipes[0], c.F_SETFL, flags | c.O_NONBLOCK);
-        }
-    }
-
-    fn destroyPipes() void {
-        for (pipes) |fd| _ = c.close(fd);
-    }
-
     pub fn createJsThunk(self: *@This(), class: *ZigClassEntry, callable: *Value, buffer: *ByteBuffer) !void {
         const fn_id = try self.saveCallback(class, callable, buffer);
         errdefer self.removeCallback(fn_id);
@@ -438,19 +536,9 @@ pub const CallDispatcher = struct {
         list.deinit(php.allocator);
     }
 
-    fn scheduleTask(self: *@This(), operation: ScheduledTask.Operation) !void {
+    fn scheduleTask(self: *@This(), task: *ScheduledTask) !void {
         if (self.multithread_count == 0) return error.Disabled;
-        const fd = self.pipe_ptr[1];
-        const task: ScheduledTask = .{ .self = self, .operation = operation };
-        if (builtin.target.os.tag == .windows) {
-            const handle: c.HANDLE = @ptrFromInt(@as(usize, @bitCast(c._get_osfhandle(fd))));
-            var written: c.DWORD = undefined;
-            if (c.WriteFile(handle, &task, @sizeOf(ScheduledTask), &written, null) == c.FALSE) return error.Unexpected;
-            if (written != @sizeOf(ScheduledTask)) return error.Unexpected;
-        } else {
-            const written = c.write(fd, @ptrCast(&task), @sizeOf(ScheduledTask));
-            if (written < 0) return error.Unexpected;
-        }
+        self.queue.post(task);
     }
 
     pub fn releaseCallingThread(handle: usize, err: E) void {
@@ -468,12 +556,10 @@ pub const CallDispatcher = struct {
         } else {
             var futex: Futex = undefined;
             call.futex_handle = futex.init();
-            self.scheduleTask(.{ .jscall = call }) catch |err| {
-                return switch (err) {
-                    error.Disabled => .PERM,
-                    else => .FAULT,
-                };
-            };
+            // task can live on the stack since we're waiting for its completion
+            var task: ScheduledTask = .{ .self = self, .operation = .{ .jscall = call } };
+            // scheduling only fails when multithreading is off, before the task gets linked
+            self.scheduleTask(&task) catch return .PERM;
             return futex.wait();
         }
     }
@@ -509,12 +595,9 @@ pub const CallDispatcher = struct {
         } else {
             var futex: Futex = undefined;
             call.futex_handle = futex.init();
-            self.scheduleTask(.{ .syscall = call }) catch |err| {
-                return switch (err) {
-                    error.Disabled => .PERM,
-                    else => .FAULT,
-                };
-            };
+            var task: ScheduledTask = .{ .self = self, .operation = .{ .syscall = call } };
+            // scheduling only fails when multithreading is off, before the task gets linked
+            self.scheduleTask(&task) catch return .PERM;
             return futex.wait();
         }
     }
@@ -562,8 +645,25 @@ pub const CallDispatcher = struct {
         return status;
     }
 
-    pub fn installHooks(self: *@This(), lib: *DynLib, redirect_syscalls: bool) !void {
-        const pos = try redirection_controller.installHooks(self, lib);
+    pub fn installHooks(self: *@This(), lib: *DynLib, redirect_syscalls: bool, state: ?*HookState) !void {
+        const pos = get: {
+            if (state) |s| {
+                if (s.extent) |extent| {
+                    // pointers in the library were replaced when it was first loaded
+                    self.env_variable_deferred = .{
+                        .address = s.env_variable_deferred.address,
+                        .read_only = s.env_variable_deferred.read_only,
+                    };
+                    break :get extent;
+                }
+            }
+            const extent = try redirection_controller.installHooks(self, lib);
+            if (state) |s| s.* = .{
+                .extent = extent,
+                .env_variable_deferred = self.env_variable_deferred,
+            };
+            break :get extent;
+        };
         if (redirect_syscalls) {
             if (self.getSyscallHook("__sc_vtable")) |hook| {
                 const vtable: *const HandlerVTable = @ptrCast(@alignCast(hook.handler));
@@ -618,7 +718,7 @@ pub const CallDispatcher = struct {
             self.multithread_count += 1;
             total_multithread_count += 1;
             if (total_multithread_count > 1) return;
-            const strm_obj = try php.openDescriptor(pipes[0], "r");
+            const strm_obj = try php.openDescriptor(task_queue.fds[0], "r");
             errdefer php.close(strm_obj, true);
             if (builtin.target.os.tag != .windows) {
                 try php.setBlocking(strm_obj, false);
@@ -639,28 +739,38 @@ pub const CallDispatcher = struct {
             if (total_multithread_count > 0) return;
             event_loop.deinit();
         } else {
-            try self.scheduleTask(.{ .disable = {} });
+            // the calling thread doesn't wait for this one
+            const task = try c_allocator.create(ScheduledTask);
+            // only reached when the task never got queued; the main thread frees it otherwise
+            errdefer c_allocator.destroy(task);
+            task.* = .{ .self = self, .operation = .{ .disable = {} } };
+            try self.scheduleTask(task);
         }
     }
 
     fn runScheduledTask() void {
-        const fd = pipes[0];
-        var task: ScheduledTask = undefined;
-        if (builtin.target.os.tag == .windows) {
-            const handle: c.HANDLE = @ptrFromInt(@as(usize, @bitCast(c._get_osfhandle(fd))));
-            var available: c.DWORD = undefined;
-            if (c.PeekNamedPipe(handle, null, 0, null, &available, null) == c.FALSE) return;
-            if (available < @sizeOf(ScheduledTask)) return;
-        }
-        const read = c.read(fd, @ptrCast(&task), @sizeOf(ScheduledTask));
-        if (read != @sizeOf(ScheduledTask)) return;
-        const self = task.self;
-        switch (task.operation) {
-            .jscall => |call| _ = self.handleJscall(call) catch unreachable,
-            .syscall => |call| _ = self.handleSyscall(call) catch unreachable,
-            .disable => self.disableMultithread() catch unreachable,
+        // clear the signal first, so that a task posted while we're draining the queue will
+        // trigger another wake-up
+        task_queue.clearSignal();
+        // threads wait for their tasks to finish, so the number of tasks is bounded by the number
+        // of threads
+        while (task_queue.take()) |task| {
+            const self = task.self;
+            switch (task.operation) {
+                .jscall => |call| _ = self.handleJscall(call) catch unreachable,
+                .syscall => |call| _ = self.handleSyscall(call) catch unreachable,
+                .disable => {
+                    c_allocator.destroy(task);
+                    self.disableMultithread() catch unreachable;
+                },
+            }
+            if (event_loop.pendingFiber != null and task_queue.hasPending()) {
+                // switching fibers might keep us from coming back here right away; make sure
+                // the remaining tasks get handled
+                task_queue.signal() catch {};
+            }
+            event_loop.resumePendingFiber();
         }
-        event_loop.resumePendingFiber();
     }
 
     pub fn initializeThread(self: *@This()) !void {
@@ -1506,6 +1616,32 @@ pub const CallDispatcher = struct {
     fn onRequestShutdown(ptr: *anyopaque) void {
         const self: *@This() = @ptrCast(@alignCast(ptr));
         self.releaseResources();
+        self.detach();
+        // the library can outlive the host when zigar.persistent is on
+        _ = self.host.module.exports.set_host_instance(null);
+    }
+
+    fn detach(self: *@This()) void {
+        if (!self.detached) {
+            self.detached = true;
+            if (self.syscall_trap_installed) {
+                if (self.getSyscallHook("__sc_vtable")) |hook| {
+                    const vtable: *const HandlerVTable = @ptrCast(@alignCast(hook.handler));
+                    redirection_controller.removeSyscallVtable(self, vtable) catch {};
+                }
+                redirection_controller.uninstallSyscallTrap();
+            }
+            const deferred = &self.env_variable_deferred;
+            if (deferred.installed) {
+                // environ would otherwise point to the list freed by deinit()
+                const hook: HookEntry = .{
+                    .handler = @ptrCast(&self.env_variable_ptr),
+                    .original = @ptrCast(&self.env_variable_original),
+                };
+                redirection_controller.uninstallHook(hook, deferred.address, deferred.read_only) catch {};
+                deferred.installed = false;
+            }
+        }
     }
 
     fn releaseResources(self: *@This()) void {
@@ -5,6 +5,7 @@ const CallDispatcher = @import("dispatch.zig").CallDispatcher;
 const dyn_lib = @import("dyn-lib.zig");
 const failure = @import("failure.zig");
 const getSharedLibraryPath = @import("compilation.zig").getSharedLibraryPath;
+const ModuleCache = @import("module-cache.zig").ModuleCache;
 const ModuleHost = @import("host.zig").ModuleHost;
 const Options = @import("options.zig").Options;
 const php = @import("php.zig");
@@ -12,6 +13,7 @@ const ArgumentIterator = php.ArgumentIterator;
 const FunctionInfo = php.FunctionInfo;
 const ExecuteData = php.ExecuteData;
 const FunctionEntry = php.FunctionEntry;
+const HashTable = php.HashTable;
 const InternalArgInfo = php.InternalArgInfo;
 const ModuleEntry = php.ModuleEntry;
 const String = php.String;
@@ -62,6 +64,7 @@ export fn php_zigar_mod_init(_: c_int, module_number: c_int) php.Result {
 }
 
 export fn php_zigar_mod_shutdown(_: c_int, module_number: c_int) php.Result {
+    ModuleCache.clear();
     ModuleHost.shutdown();
     Options.shutdown(module_number);
     return php.SUCCESS;
@@ -170,12 +173,9 @@ const functions = struct {
             defer if (src_path) |path| php.allocator.free(path);
             defer php.allocator.free(mod_path);
             const params = if (arg_iter.next()) |arg1| try php.getValueHashTable(arg1) else null;
-            if (src_path) |path| {
-                if (options.recompile) try ZigCompiler.compile(path, mod_path, params);
-            }
-            const so_path = try getSharedLibraryPath(php.allocator, mod_path, .this, .this);
+            const so_path, const cached = try prepareModule(src_path, mod_path, params);
             defer php.allocator.free(so_path);
-            retval.* = try ModuleHost.load(so_path);
+            retval.* = try ModuleHost.load(so_path, cached);
         }
     };
     pub const zigar_import = struct {
@@ -220,12 +220,9 @@ const functions = struct {
                 break :get arg_iter.next();
             } else null;
             const params = if (arg_iter.next()) |arg2| try php.getValueHashTable(arg2) else null;
-            if (src_path) |path| {
-                if (options.recompile) try ZigCompiler.compile(path, mod_path, params);
-            }
-            const so_path = try getSharedLibraryPath(php.allocator, mod_path, .this, .this);
+            const so_path, const cached = try prepareModule(src_path, mod_path, params);
             defer php.allocator.free(so_path);
-            const root = try ModuleHost.load(so_path);
+            const root = try ModuleHost.load(so_path, cached);
             retval.* = root;
             // export symbols from root namespace
             const root_class = try ZigClassEntry.fromValue(&root);
@@ -236,6 +233,29 @@ const functions = struct {
         }
     };
 
+    fn prepareModule(src_path: ?[]const u8, mod_path: []const u8, params: ?*HashTable) !struct { []const u8, ?*ModuleCache.Entry } {
+        const so_path = try getSharedLibraryPath(php.allocator, mod_path, .this, .this);
+        errdefer php.allocator.free(so_path);
+        if (!options.persistent) {
+            if (src_path) |path| {
+                if (options.recompile) try ZigCompiler.compile(path, mod_path, params);
+            }
+            return .{ so_path, null };
+        }
+        const params_hash = try ModuleCache.hashParams(params);
+        // a library kept loaded from an earlier request is used as is
+        const entry = ModuleCache.find(mod_path) orelse add: {
+            if (src_path) |path| {
+                if (options.recompile) try ZigCompiler.compile(path, mod_path, params);
+            }
+            break :add try ModuleCache.add(mod_path, params_hash, so_path);
+        };
+        if (entry.params_hash != params_hash) {
+            return failure.report("module '{s}' is already loaded with different parameters", .{mod_path});
+        }
+        return .{ so_path, entry };
+    }
+
     fn deriveModulePath(allocator: std.mem.Allocator, src_path: []const u8) ![]const u8 {
         const src_dir = std.fs.path.dirname(src_path) orelse "";
         const src_name = std.fs.path.stem(src_path);
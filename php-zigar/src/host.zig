@@ -7,9 +7,12 @@ const BufferMap = @import("buffer.zig").BufferMap;
 const ByteBuffer = @import("buffer.zig").ByteBuffer;
 const CallDispatcher = @import("dispatch.zig").CallDispatcher;
 const DynLib = @import("dyn-lib.zig").DynLib;
+const extension = @import("extension.zig");
 const GarbageCollectionBuffer = @import("gc.zig").GarbageCollectionBuffer;
+const ImportLog = @import("import.zig").ImportLog;
 const js_compat = @import("js-compat.zig");
 const ArgStruct = @import("module/arg-struct.zig").ArgStruct;
+const ModuleCache = @import("module-cache.zig").ModuleCache;
 const ModuleGeneric = @import("module/native/interface.zig").Module;
 const ObjectMap = @import("object.zig").ObjectMap;
 const php = @import("php.zig");
@@ -47,6 +50,8 @@ pub const ModuleHost = struct {
     const AllocatorMethodId = enum(usize) { alloc = 1, resize, remap, free };
 
     threadlocal var prev_cache_mask: usize = 0;
+    // smaller allocations aren't worth sharing with PHP
+    const min_shared_string_len = 4096;
 
     pub fn setup() !void {
         try ZigClassEntry.registerRootClass();
@@ -67,7 +72,7 @@ pub const ModuleHost = struct {
         CallDispatcher.uninstallHandlers();
     }
 
-    pub fn load(path: []const u8) !Value {
+    pub fn load(path: []const u8, cached: ?*ModuleCache.Entry) !Value {
         var lib: DynLib = try DynLib.open(path);
         errdefer lib.close();
         const module = lib.lookup(*Module, "zig_module") orelse return error.MissingSymbol;
@@ -89,15 +94,20 @@ pub const ModuleHost = struct {
         // install hooks
         self.dispatcher = try .init(self);
         errdefer self.dispatcher.deinit();
-        try self.dispatcher.installHooks(&lib, module.attributes.io_redirection);
+        const hook_state = if (cached) |entry| &entry.hook_state else null;
+        try self.dispatcher.installHooks(&lib, module.attributes.io_redirection, hook_state);
         _ = module.exports.set_host_instance(@ptrCast(self));
         _ = module.exports.set_language_name("PHP");
         self.importer = try .init(self);
         defer self.importer.deinit();
         try self.exportFunctionsToModule();
-        // retrieve and run factory thunk
-        const thunk_address: usize = try self.getFactoryThunk();
-        try self.runThunk(thunk_address, 0xDEADC0DE, 0xDEADC0DE);
+        if (cached) |entry| {
+            entry.mutex.lock();
+            defer entry.mutex.unlock();
+            try self.importStructures(&entry.import_log);
+        } else {
+            try self.importStructures(null);
+        }
         // activate acquired structures and get the root
         const root_class_obj = try self.importer.activateStructures();
         errdefer php.release(root_class_obj);
@@ -106,6 +116,22 @@ pub const ModuleHost = struct {
         return php.createValueObject(root_class_obj);
     }
 
+    fn importStructures(self: *@This(), log: ?*ImportLog) !void {
+        if (log) |l| {
+            if (l.complete) {
+                // the factory function was run by an earlier request
+                return self.importer.replay(l);
+            }
+            self.importer.log = l;
+        }
+        defer self.importer.log = null;
+        errdefer if (log) |l| l.reset();
+        // retrieve and run factory thunk
+        const thunk_address: usize = try self.getFactoryThunk();
+        try self.runThunk(thunk_address, 0xDEADC0DE, 0xDEADC0DE);
+        if (log) |l| l.complete = true;
+    }
+
     pub fn addRef(self: *@This()) void {
         self.ref_count += 1;
     }
@@ -179,6 +205,14 @@ pub const ModuleHost = struct {
                     };
                     const retval = @call(.auto, func, args);
                     if (retval) |payload| {
+                        if (Component == StructureImporter) {
+                            if (args[0].log) |log| {
+                                var op_args: @FieldType(ImportLog.Op, field.name) = undefined;
+                                inline for (&op_args, 0..) |*ptr, i| ptr.* = args[i + 1];
+                                const result: ?StructureImporter.Handle = if (Payload == void) null else payload;
+                                log.add(@unionInit(ImportLog.Op, field.name, op_args), result) catch return .FAULT;
+                            }
+                        }
                         if (Payload == E) return payload;
                         if (extra == 1) new_args[new_args.len - 1].* = payload;
                         return .SUCCESS;
@@ -350,12 +384,25 @@ pub const ModuleHost = struct {
     fn allocateMemory(host: *ModuleHost, len: usize, alignment: std.mem.Alignment) !*ByteBuffer {
         const buf = try ByteBuffer.create(alignment);
         errdefer buf.release();
-        try buf.allocate(null, len);
+        if (extension.options.share_strings and alignment == .@"1" and len >= min_shared_string_len) {
+            // bytes might end up being returned as a string
+            buf.allocateString(len);
+        } else {
+            try buf.allocate(null, len);
+        }
         const result = host.unclaimed_buffer_map.find(buf);
         try host.unclaimed_buffer_map.insert(result, buf);
         return buf;
     }
 
+    fn shrinkMemory(host: *ModuleHost, memory: []u8, new_len: usize) void {
+        // keep the length of the string in sync so it can still be handed to PHP
+        const unclaimed_result = host.unclaimed_buffer_map.find(.{ .bytes = memory });
+        if (host.unclaimed_buffer_map.get(unclaimed_result)) |buf| {
+            if (buf.flags.shareable) buf.shrinkString(new_len);
+        }
+    }
+
     fn freeMemory(host: *ModuleHost, memory: []u8, alignment: std.mem.Alignment) void {
         // try releasing buffer that has just been allocated
         const unclaimed_result = host.unclaimed_buffer_map.find(.{
@@ -385,13 +432,15 @@ pub const ModuleHost = struct {
         }
 
         fn resize(
-            _: *ModuleHost,
+            host: *ModuleHost,
             memory: []u8,
             _: std.mem.Alignment,
             new_len: usize,
             _: usize,
         ) bool {
-            return new_len <= memory.len;
+            if (new_len > memory.len) return false;
+            if (new_len < memory.len) host.shrinkMemory(memory, new_len);
+            return true;
         }
 
         fn remap(
@@ -418,7 +467,7 @@ pub const ModuleHost = struct {
     };
 };
 
-inline fn camelize(comptime name: []const u8) [:0]const u8 {
+pub inline fn camelize(comptime name: []const u8) [:0]const u8 {
     var buffer: [name.len + 1]u8 = undefined;
     var len: usize = 0;
     var capitalize = false;
@@ -2,6 +2,7 @@ const std = @import("std");
 
 const BufferMap = @import("buffer.zig").BufferMap;
 const ByteBuffer = @import("buffer.zig").ByteBuffer;
+const camelize = @import("host.zig").camelize;
 const Comptime = @import("structure.zig").Comptime;
 const Function = @import("structure.zig").Function;
 const hooks = @import("module/native/hooks.zig");
@@ -30,6 +31,7 @@ pub const StructureImporter = struct {
         @"opaque": usize = 0,
     } = .{},
     host: *ModuleHost,
+    log: ?*ImportLog = null,
 
     pub const Handle = *opaque {};
 
@@ -75,6 +77,20 @@ pub const StructureImporter = struct {
         return php.reuse(root_obj);
     }
 
+    pub fn replay(self: *@This(), log: *const ImportLog) !void {
+        for (log.calls.items) |call| {
+            const result: ?Handle = switch (call.op) {
+                inline else => |args, tag| run: {
+                    const method = @field(@This(), comptime camelize(@tagName(tag)));
+                    const retval = try @call(.auto, method, .{self} ++ args);
+                    break :run if (@TypeOf(retval) == void) null else retval;
+                },
+            };
+            // handles are indices into value_list, so the same calls should yield the same handles
+            if (result != call.result) return error.Unexpected;
+        }
+    }
+
     fn obtainHandle(self: *@This(), value: Value) Handle {
         return self.findHandle(value) orelse self.addHandle(value);
     }
@@ -297,3 +313,110 @@ pub const StructureImporter = struct {
         try func_class.enableCallback(template, member_flags);
     }
 };
+
+// calls made by a module's factory function, kept so that the same structures can be imported
+// again without running it
+pub const ImportLog = struct {
+    arena: std.heap.ArenaAllocator,
+    calls: std.ArrayList(Call) = .empty,
+    complete: bool = false,
+
+    const Handle = StructureImporter.Handle;
+    const Module = ModuleGeneric(Handle);
+
+    pub const Call = struct {
+        op: Op,
+        result: ?Handle,
+    };
+    // a union holding the arguments of each import implemented by StructureImporter
+    pub const Op = define: {
+        @setEvalBranchQuota(200000);
+        const import_fields = std.meta.fields(Module.Imports);
+        var enum_fields: [import_fields.len]std.builtin.Type.EnumField = undefined;
+        var union_fields: [import_fields.len]std.builtin.Type.UnionField = undefined;
+        var count = 0;
+        for (import_fields) |field| {
+            const name_c = camelize(field.name);
+            if (!@hasDecl(StructureImporter, name_c)) continue;
+            const params = @typeInfo(@TypeOf(@field(StructureImporter, name_c))).@"fn".params;
+            var types: [params.len - 1]type = undefined;
+            for (params[1..], 0..) |param, i| types[i] = param.type.?;
+            const Args = std.meta.Tuple(&types);
+            enum_fields[count] = .{ .name = field.name, .value = count };
+            union_fields[count] = .{ .name = field.name, .type = Args, .alignment = @alignOf(Args) };
+            count += 1;
+        }
+        const final_enum_fields = enum_fields[0..count].*;
+        const final_union_fields = union_fields[0..count].*;
+        const Tag = @Type(.{
+            .@"enum" = .{
+                .tag_type = u8,
+                .fields = &final_enum_fields,
+                .decls = &.{},
+                .is_exhaustive = true,
+            },
+        });
+        break :define @Type(.{
+            .@"union" = .{
+                .layout = .auto,
+                .tag_type = Tag,
+                .fields = &final_union_fields,
+                .decls = &.{},
+            },
+        });
+    };
+
+    pub fn init() @This() {
+        // memory has to outlive the request
+        return .{ .arena = .init(std.heap.c_allocator) };
+    }
+
+    pub fn deinit(self: *@This()) void {
+        self.arena.deinit();
+    }
+
+    pub fn reset(self: *@This()) void {
+        _ = self.arena.reset(.free_all);
+        self.calls = .empty;
+        self.complete = false;
+    }
+
+    pub fn add(self: *@This(), op: Op, result: ?Handle) !void {
+        const allocator = self.arena.allocator();
+        // bytes passed by pointer might not stay valid
+        const copy: Op = switch (op) {
+            .create_string => |args| .{
+                .create_string = .{ try self.copyBytes(args[0], args[1]), args[1] },
+            },
+            .create_view => |args| .{
+                .create_view = if (args[2]) .{
+                    if (args[0]) |ptr| try self.copyBytes(ptr, args[1]) else null,
+                    args[1],
+                    args[2],
+                    args[3],
+                    args[4],
+                    args[5],
+                } else args,
+            },
+            .get_property => |args| .{
+                .get_property = .{ args[0], try self.copyBytes(args[1], args[2]), args[2] },
+            },
+            .set_property => |args| .{
+                .set_property = .{ args[0], try self.copyBytes(args[1], args[2]), args[2], args[3] },
+            },
+            .get_structure => |args| .{
+                .get_structure = .{ try self.copyBytes(args[0], args[1]), args[1] },
+            },
+            .set_structure => |args| .{
+                .set_structure = .{ try self.copyBytes(args[0], args[1]), args[1], args[2] },
+            },
+            else => op,
+        };
+        try self.calls.append(allocator, .{ .op = copy, .result = result });
+    }
+
+    fn copyBytes(self: *@This(), ptr: [*]const u8, len: usize) ![*]const u8 {
+        const bytes = try self.arena.allocator().dupe(u8, ptr[0..len]);
+        return bytes.ptr;
+    }
+};
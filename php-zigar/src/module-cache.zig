@@ -0,0 +1,83 @@
+const std = @import("std");
+
+const CallDispatcher = @import("dispatch.zig").CallDispatcher;
+const DynLib = @import("dyn-lib.zig").DynLib;
+const ImportLog = @import("import.zig").ImportLog;
+const Options = @import("options.zig").Options;
+const php = @import("php.zig");
+const HashTable = php.HashTable;
+
+// when zigar.persistent is on, libraries stay loaded until the process ends, so that subsequent
+// requests (in FPM workers forked after opcache.preload, for instance) do not need to check the
+// source code for changes or link the library again; the calls made by the factory function are
+// recorded the first time around and replayed afterward, while every request still gets its own
+// host and class entries, since these are tied to the request's object store
+pub const ModuleCache = struct {
+    pub const Entry = struct {
+        mod_path: []const u8,
+        params_hash: u64,
+        lib: DynLib,
+        hook_state: CallDispatcher.HookState = .{},
+        import_log: ImportLog,
+        mutex: std.Thread.Mutex = .{},
+    };
+
+    // memory has to outlive the request
+    const allocator = std.heap.c_allocator;
+
+    var entries: std.ArrayList(*Entry) = .empty;
+    var mutex: std.Thread.Mutex = .{};
+
+    pub fn find(mod_path: []const u8) ?*Entry {
+        mutex.lock();
+        defer mutex.unlock();
+        return for (entries.items) |entry| {
+            if (std.mem.eql(u8, entry.mod_path, mod_path)) break entry;
+        } else null;
+    }
+
+    pub fn add(mod_path: []const u8, params_hash: u64, so_path: []const u8) !*Entry {
+        mutex.lock();
+        defer mutex.unlock();
+        for (entries.items) |entry| {
+            // another thread got here first
+            if (std.mem.eql(u8, entry.mod_path, mod_path)) return entry;
+        }
+        // keep a handle so the library isn't unloaded when the host closes its own
+        var lib = try DynLib.open(so_path);
+        errdefer lib.close();
+        const mod_path_copy = try allocator.dupe(u8, mod_path);
+        errdefer allocator.free(mod_path_copy);
+        const entry = try allocator.create(Entry);
+        errdefer allocator.destroy(entry);
+        entry.* = .{
+            .mod_path = mod_path_copy,
+            .params_hash = params_hash,
+            .lib = lib,
+            .import_log = .init(),
+        };
+        try entries.append(allocator, entry);
+        return entry;
+    }
+
+    pub fn hashParams(params: ?*HashTable) !u64 {
+        // start from the defaults, so that only what's given in params matters
+        var options: Options = .init();
+        if (params) |ht| try options.override(ht);
+        var hasher: std.hash.Wyhash = .init(0);
+        std.hash.autoHashStrat(&hasher, options, .Deep);
+        return hasher.final();
+    }
+
+    pub fn clear() void {
+        mutex.lock();
+        defer mutex.unlock();
+        for (entries.items) |entry| {
+            entry.import_log.deinit();
+            entry.lib.close();
+            allocator.free(entry.mod_path);
+            allocator.destroy(entry);
+        }
+        entries.clearAndFree(allocator);
+    }
+};
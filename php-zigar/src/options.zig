@@ -27,6 +27,8 @@ pub const Options = struct {
     arch: Arch = .this,
     platform: Platform = .this,
     quiet: bool = false,
+    share_strings: bool = false,
+    persistent: bool = false,
     ignore_build_file: bool = false,
     omit_functions: bool = false,
     omit_variables: bool = false,
@@ -203,7 +205,7 @@ pub const Options = struct {
                 .value = default_value,
                 .value_length = @intCast(std.mem.len(default_value)),
                 .modifiable = switch (field_enum) {
-                    .recompile => php.INI_SYSTEM,
+                    .recompile, .persistent => php.INI_SYSTEM,
                     else => php.INI_ALL,
                 },
                 .on_modify = switch (field.type) {
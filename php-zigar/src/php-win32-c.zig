@@ -37,6 +37,7 @@ const ZendFastCall = enum {
     _emalloc,
     _is_numeric_string_ex,
     _zend_hash_init,
+    _zend_new_array,
     _zend_new_array_0,
     convert_to_array,
     convert_to_boolean,
@@ -61,6 +62,7 @@ const ZendFastCall = enum {
     zend_hash_move_backwards_ex,
     zend_hash_move_forward_ex,
     zend_hash_next_index_insert,
+    zend_hash_real_init_packed,
     zend_hash_str_del,
     zend_hash_str_find,
     zend_hash_str_update,
@@ -120,6 +122,7 @@ pub var _php_stream_tell: Ptr("_php_stream_tell") = undefined;
 pub var _php_stream_truncate_set_size: Ptr("_php_stream_truncate_set_size") = undefined;
 pub var _php_stream_write: Ptr("_php_stream_write") = undefined;
 pub var _zend_hash_init: Ptr("_zend_hash_init") = undefined;
+pub var _zend_new_array: Ptr("_zend_new_array") = undefined;
 pub var _zend_new_array_0: Ptr("_zend_new_array_0") = undefined;
 pub var compiler_globals: switch (@hasDecl(c, "ZTS")) {
     false => Ptr("compiler_globals"),
@@ -201,6 +204,7 @@ pub var zend_hash_internal_pointer_reset_ex: Ptr("zend_hash_internal_pointer_res
 pub var zend_hash_move_backwards_ex: Ptr("zend_hash_move_backwards_ex") = undefined;
 pub var zend_hash_move_forward_ex: Ptr("zend_hash_move_forward_ex") = undefined;
 pub var zend_hash_next_index_insert: Ptr("zend_hash_next_index_insert") = undefined;
+pub var zend_hash_real_init_packed: Ptr("zend_hash_real_init_packed") = undefined;
 pub var zend_hash_str_del: Ptr("zend_hash_str_del") = undefined;
 pub var zend_hash_str_find: Ptr("zend_hash_str_find") = undefined;
 pub var zend_hash_str_update: Ptr("zend_hash_str_update") = undefined;
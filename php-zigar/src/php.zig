@@ -705,7 +705,7 @@ pub fn getValueDouble(value: *const Value) !f64 {
     };
 }
 
-fn longToDouble(value: Long) !f64 {
+pub fn longToDouble(value: Long) !f64 {
     @setRuntimeSafety(false);
     const double: f64 = @floatFromInt(value);
     const long: Long = @intFromFloat(double);
@@ -948,6 +948,59 @@ pub fn getHashLength(ht: *const HashTable) usize {
     return ht.nNumOfElements;
 }
 
+/// Storage of a packed array without holes, i.e. a list, whose elements can be accessed directly
+/// instead of going through the hash table API
+pub const PackedValues = struct {
+    ptr: [*]u8,
+    stride: usize,
+    len: usize,
+
+    pub inline fn at(self: @This(), index: usize) *Value {
+        return @ptrCast(@alignCast(self.ptr + index * self.stride));
+    }
+};
+
+pub fn getPackedValues(ht: *HashTable) ?PackedValues {
+    if (ht.u.flags & c.HASH_FLAG_PACKED == 0) return null;
+    if (ht.nNumUsed != ht.nNumOfElements) return null;
+    return getPackedStorage(ht, ht.nNumOfElements);
+}
+
+/// Create a packed array of the given length; every element must be set before the array is used
+pub fn createPackedArray(len: usize) !struct { *Array, PackedValues } {
+    if (len > std.math.maxInt(u32)) return error.TooLarge;
+    const ht = pc._zend_new_array(@intCast(len));
+    if (len == 0) return .{ ht, getPackedStorage(ht, 0) };
+    pc.zend_hash_real_init_packed(ht);
+    const values = getPackedStorage(ht, len);
+    if (comptime @hasField(HashTable, "arData")) {
+        for (0..len) |i| {
+            const bucket: *c.Bucket = @ptrCast(@alignCast(values.at(i)));
+            bucket.h = i;
+            bucket.key = null;
+        }
+    }
+    ht.nNumUsed = @intCast(len);
+    ht.nNumOfElements = @intCast(len);
+    ht.nNextFreeElement = @intCast(len);
+    return .{ ht, values };
+}
+
+fn getPackedStorage(ht: *HashTable, len: usize) PackedValues {
+    if (comptime @hasField(HashTable, "arData")) {
+        // PHP 8.1 uses buckets for packed arrays as well; the value is the first field
+        return .{ .ptr = @ptrCast(ht.arData), .stride = @sizeOf(c.Bucket), .len = len };
+    } else {
+        // arPacked is in an anonymous union
+        inline for (comptime std.meta.fields(HashTable)) |field| {
+            if (comptime @typeInfo(field.type) == .@"union" and @hasField(field.type, "arPacked")) {
+                return .{ .ptr = @ptrCast(@field(ht, field.name).arPacked), .stride = @sizeOf(Value), .len = len };
+            }
+        }
+        @compileError("Unable to locate storage of packed array");
+    }
+}
+
 pub fn getHashEntry(ht: *const HashTable, key: anytype) !*Value {
     const KT = @TypeOf(key);
     if (KT == *Value or KT == *const Value) {
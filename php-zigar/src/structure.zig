@@ -666,9 +666,11 @@ pub fn ArrayLike(comptime S: type) type {
                     if (bytes.len == len) {
                         switch (self.buffer.source_type) {
                             .string => {
-                                // return the original string if possible
+                                // return the original string if possible; a string holding memory
+                                // allocated by Zig can only be shared once it can no longer change
                                 const str = self.buffer.source.string;
-                                if (str.len == len) return php.createValueString(php.reuse(str));
+                                const shareable = !self.buffer.flags.shareable or self.buffer.flags.read_only;
+                                if (str.len == len and shareable) return php.createValueString(php.reuse(str));
                             },
                             else => {},
                         }
@@ -702,6 +704,12 @@ pub fn ArrayLike(comptime S: type) type {
 
         fn createPlainArray(self: *S, elem_transform: accessor.Transform) !Value {
             const len = self.getLength();
+            if (elem_transform == .plain) {
+                // numbers can be copied into a packed array in one go
+                const class = ZigClassEntry.fromStructure(self);
+                const static = class.getStaticData(S);
+                if (try static.value_acc.getElements(self, len)) |value| return value;
+            }
             const ht = php.createArray();
             for (0..len) |i| {
                 var value = try self.getElement(i);
@@ -741,6 +749,14 @@ pub fn ArrayLike(comptime S: type) type {
                     }
                     const ht = try php.getValueArray(value);
                     const len = self.getLength();
+                    if (php.getPackedValues(ht)) |values| {
+                        // skip per-element accessor calls when given a list of numbers
+                        if (values.len <= len) {
+                            const class = ZigClassEntry.fromStructure(self);
+                            const static = class.getStaticData(S);
+                            if (try static.value_acc.setElements(self, values)) return;
+                        }
+                    }
                     var iter: HashTableIterator = .init(ht, .{});
                     while (iter.next()) |field_value| {
                         const key = iter.currentIndex() orelse return error.KeyIsNotInteger;
@@ -0,0 +1,304 @@
+<?php declare(strict_types=1);
+
+final class CallOverheadTest extends ZigarTestCase
+{
+    static $results = [];
+
+    public static function tearDownAfterClass(): void
+    {
+        // results are saved as JSON when ZIGAR_BENCHMARK_REPORT points to a directory, so that
+        // numbers from different releases can be compared
+        $dir = getenv('ZIGAR_BENCHMARK_REPORT');
+        if ($dir && count(self::$results) > 0) {
+            if (!is_dir($dir)) {
+                mkdir($dir, 0777, true);
+            }
+            $optimize = ZigImporter::$optimize;
+            $report = [
+                'runtime' => 'php',
+                'runtimeVersion' => PHP_VERSION,
+                'target' => PHP_OS_FAMILY,
+                'optimize' => $optimize,
+                'date' => date('c'),
+                'results' => self::$results,
+            ];
+            $path = "$dir/call-overhead-php-" . strtolower(PHP_OS_FAMILY) . "-$optimize.json";
+            file_put_contents($path, json_encode($report, JSON_PRETTY_PRINT));
+        }
+    }
+
+    private static function record(string $name, float $elapsed, int $count, string $unit = 'call'): string
+    {
+        $ns = $elapsed / $count;
+        self::$results[$name] = [ 'ns' => $ns, 'unit' => $unit ];
+        return sprintf("%s: %.3fµs per %s", $name, $ns / 1000, $unit);
+    }
+
+    private static function measure(string $name, int $iterations, callable $f): string
+    {
+        for ($i = 0; $i < min($iterations, 100); $i++) {
+            $f($i);
+        }
+        $start = hrtime(true);
+        for ($i = 0; $i < $iterations; $i++) {
+            $f($i);
+        }
+        return self::record($name, hrtime(true) - $start, $iterations);
+    }
+
+    public function testMeasureCostOfMarshalingDifferentArgumentTypes(): void
+    {
+        if (ZigImporter::$optimize === 'Debug') {
+            $this->markTestSkipped('Benchmark requires an optimized build');
+        }
+        $m = ZigImporter::load(__DIR__ . '/marshaling.zig');
+        $iterations = 100000;
+        $text = str_repeat('Hello world', 10);
+        $array = array_fill(0, 1000, 0.5);
+        $this->assertSame(strlen($text), $m->getLength($text));
+        $this->assertSame('Hello, Bob!', $m->getGreeting('Bob'));
+        $this->assertSame(500.0, $m->sum($array));
+        // slice allocated on the Zig side can be passed back without copying
+        $slice = $m->duplicate($array);
+        $this->assertSame(500.0, $m->sum($slice));
+        $nested = [ $slice, $slice, $slice, $slice ];
+        $this->assertSame(2000.0, $m->sumNested($nested));
+        $this->assertSame(6, $m->callRepeatedly(fn($i) => $i, 4));
+        $results = [
+            self::measure('empty()', $iterations, fn() => $m->empty()),
+            self::measure('add(i32, i32)', $iterations, fn($i) => $m->add($i, 1)),
+            self::measure('getLength([]const u8)', $iterations, fn() => $m->getLength($text)),
+            self::measure('getGreeting(Allocator, []const u8) []const u8', $iterations / 10, fn() => $m->getGreeting('Bob')),
+            self::measure('sum([]const f64, copied)', $iterations / 10, fn() => $m->sum($array)),
+            self::measure('sum([]const f64, zero-copy)', $iterations / 10, fn() => $m->sum($slice)),
+            self::measure('sumNested([]const []const f64)', $iterations / 10, fn() => $m->sumNested($nested)),
+            self::measure('duplicate(Allocator, []const f64) []f64', $iterations / 10, fn() => $m->duplicate($slice)),
+        ];
+        $callback_count = 10000;
+        $start = hrtime(true);
+        $m->callRepeatedly(fn($i) => $i, $callback_count);
+        $results[] = self::record('callback (main thread)', hrtime(true) - $start, $callback_count, 'callback');
+        echo "\n" . implode("\n", $results) . "\n";
+    }
+
+    public function testMeasureCostOfConvertingLargeArrays(): void
+    {
+        if (ZigImporter::$optimize === 'Debug') {
+            $this->markTestSkipped('Benchmark requires an optimized build');
+        }
+        $m = ZigImporter::load(__DIR__ . '/packed-arrays.zig');
+        $count = 1000000;
+        $ints = range(0, $count - 1);
+        $floats = array_fill(0, $count, 0.5);
+        // preserving the keys in reverse order yields arrays that aren't packed, forcing the
+        // element-by-element path
+        $int_hash = array_reverse($ints, true);
+        $float_hash = array_reverse($floats, true);
+        $int_sum = $count * ($count - 1) / 2;
+        $this->assertSame($int_sum, $m->sumInts($ints));
+        $this->assertSame($int_sum, $m->sumInts($int_hash));
+        $this->assertSame($count * 0.5, $m->sumFloats($floats));
+        $this->assertSame($count * 0.5, $m->sumFloats($float_hash));
+        $this->assertSame([ 0, 2, 4 ], array_slice($m->scaleInts($ints, 2), 0, 3));
+        $this->assertSame([ 1.0, 1.0, 1.0 ], array_slice($m->scaleFloats($floats, 2.0), 0, 3));
+        $iterations = 10;
+        $results = [
+            self::measure('sumInts([]const i64, packed)', $iterations, fn() => $m->sumInts($ints)),
+            self::measure('sumInts([]const i64, hash)', $iterations, fn() => $m->sumInts($int_hash)),
+            self::measure('sumFloats([]const f64, packed)', $iterations, fn() => $m->sumFloats($floats)),
+            self::measure('sumFloats([]const f64, hash)', $iterations, fn() => $m->sumFloats($float_hash)),
+            self::measure('scaleInts([]const i32) []i32, round trip', $iterations, fn() => $m->scaleInts($ints, 2)),
+            self::measure('scaleFloats([]const f32) []f32, round trip', $iterations, fn() => $m->scaleFloats($floats, 2.0)),
+        ];
+        echo "\n" . implode("\n", $results) . "\n";
+    }
+
+    public function testMeasureCostOfReturningLargeStrings(): void
+    {
+        if (ZigImporter::$optimize === 'Debug') {
+            $this->markTestSkipped('Benchmark requires an optimized build');
+        }
+        $m = ZigImporter::load(__DIR__ . '/large-strings.zig');
+        $len = 4 * 1024 * 1024;
+        $iterations = 20;
+        $results = [];
+        $previous = ini_get('zigar.share_strings');
+        try {
+            foreach ([ 'copied' => '0', 'shared' => '1' ] as $mode => $setting) {
+                ini_set('zigar.share_strings', $setting);
+                $text = $m->render($len);
+                $this->assertSame($len, strlen($text));
+                $this->assertSame('abc', substr($text, 0, 3));
+                unset($text);
+                $results[] = self::measure("render(4MB) []const u8, $mode", $iterations, fn() => $m->render($len));
+                if (function_exists('memory_reset_peak_usage')) {
+                    // peak memory usage during the call, when a copy is made of the Zig memory
+                    $before = memory_get_usage();
+                    memory_reset_peak_usage();
+                    $text = $m->render($len);
+                    $bytes = memory_get_peak_usage() - $before;
+                    unset($text);
+                    self::$results["render(4MB) []const u8, $mode, peak memory"] = [ 'bytes' => $bytes, 'unit' => 'call' ];
+                    $results[] = sprintf("render(4MB) []const u8, %s: %.1fMB peak memory", $mode, $bytes / (1024 * 1024));
+                }
+            }
+        } finally {
+            ini_set('zigar.share_strings', $previous);
+        }
+        echo "\n" . implode("\n", $results) . "\n";
+    }
+
+    public function testMeasureRequestsPerSecond(): void
+    {
+        if (ZigImporter::$optimize === 'Debug') {
+            $this->markTestSkipped('Benchmark requires an optimized build');
+        }
+        // make sure the module is built before the servers start
+        ZigImporter::load(__DIR__ . '/request.zig');
+        $results = [];
+        // the built-in web server goes through request startup and shutdown like an FPM worker
+        foreach ([ 'transient' => 'Off', 'persistent' => 'On' ] as $mode => $setting) {
+            $socket = stream_socket_server('tcp://127.0.0.1:0');
+            $address = stream_socket_get_name($socket, false);
+            fclose($socket);
+            $cmd = [ PHP_BINARY ];
+            if ($ini_path = php_ini_loaded_file()) {
+                array_push($cmd, '-c', $ini_path);
+            }
+            array_push($cmd,
+                '-d', "zigar.persistent=$setting",
+                '-d', 'zigar.module_rel_path=./lib',
+                '-S', $address,
+                __DIR__ . '/request.php'
+            );
+            $env = [ 'OPTIMIZE' => ZigImporter::$optimize ] + getenv();
+            $null = PHP_OS_FAMILY === 'Windows' ? 'NUL' : '/dev/null';
+            $descriptors = [ 1 => [ 'file', $null, 'w' ], 2 => [ 'file', $null, 'w' ] ];
+            $server = proc_open($cmd, $descriptors, $pipes, null, $env);
+            try {
+                $url = "http://$address/";
+                // wait for the server to come up; the first request also loads the module
+                for ($i = 0; $i < 100 && @file_get_contents($url) === false; $i++) {
+                    usleep(50000);
+                }
+                $this->assertSame('3', file_get_contents($url));
+                $count = 200;
+                $start = hrtime(true);
+                for ($i = 0; $i < $count; $i++) {
+                    file_get_contents($url);
+                }
+                $elapsed = hrtime(true) - $start;
+                $rps = $count * 1e9 / $elapsed;
+                self::$results["request calling add(i32, i32), $mode"] = [ 'rps' => $rps, 'unit' => 'second' ];
+                $results[] = sprintf("request calling add(i32, i32), %s: %.1f requests per second", $mode, $rps);
+            } finally {
+                proc_terminate($server);
+                proc_close($server);
+            }
+        }
+        echo "\n" . implode("\n", $results) . "\n";
+    }
+
+    public function testMeasureCostOfCallsCrossingThreads(): void
+    {
+        if (ZigImporter::$optimize === 'Debug') {
+            $this->markTestSkipped('Benchmark requires an optimized build');
+        }
+        $m = ZigImporter::load(__DIR__ . '/threading.zig');
+        $this->inEventLoops([ 'revolt' ], function() use($m) {
+            $m->startup();
+            try {
+                $results = [];
+                $callback_count = 10000;
+                $start = hrtime(true);
+                $total = $m->callFromThread(fn($i) => 1, $callback_count);
+                $results[] = self::record('callback (worker thread)', hrtime(true) - $start, $callback_count, 'callback');
+                $this->assertSame($callback_count, $total);
+                $promise_count = 1000;
+                $start = hrtime(true);
+                for ($i = 0; $i < $promise_count; $i++) {
+                    $m->returnInt($i);
+                }
+                $results[] = self::record('promise (work queue)', hrtime(true) - $start, $promise_count, 'promise');
+                $item_count = 10000;
+                $received = 0;
+                $start = hrtime(true);
+                foreach ($m->generate($item_count) as $value) {
+                    $received++;
+                }
+                $results[] = self::record('generator (worker thread)', hrtime(true) - $start, $item_count, 'item');
+                $this->assertSame($item_count, $received);
+                echo "\n" . implode("\n", $results) . "\n";
+            } finally {
+                $m->shutdown();
+            }
+        });
+    }
+
+    public function testMeasureCostOfPrintingFromThread(): void
+    {
+        if (ZigImporter::$optimize === 'Debug') {
+            $this->markTestSkipped('Benchmark requires an optimized build');
+        }
+        $m = ZigImporter::load(__DIR__ . '/output.zig');
+        $this->inEventLoops([ 'revolt' ], function() use($m) {
+            $m->startup();
+            try {
+                $line_count = 10000;
+                $before = $m->getOutputStats();
+                ob_start();
+                try {
+                    $start = hrtime(true);
+                    // the call returns once the thread has flushed its output
+                    $m->printLines($line_count);
+                    $elapsed = hrtime(true) - $start;
+                } finally {
+                    $output = ob_get_clean();
+                }
+                $after = $m->getOutputStats();
+                $this->assertSame($line_count, substr_count($output, "\n"));
+                $this->assertStringEndsWith('Line ' . ($line_count - 1) . "\n", $output);
+                // lines are sent to the main thread in batches
+                $writes = $after->writes - $before->writes;
+                $flushes = $after->flushes - $before->flushes;
+                $this->assertGreaterThanOrEqual($line_count, $writes);
+                $this->assertLessThan($line_count, $flushes);
+                $this->assertSame(strlen($output), $after->bytes - $before->bytes);
+                $results = [
+                    self::record('std.debug.print() (worker thread)', $elapsed, $line_count, 'line'),
+                    sprintf("%d lines sent in %d flush(es)", $line_count, $flushes),
+                ];
+                echo "\n" . implode("\n", $results) . "\n";
+            } finally {
+                $m->shutdown();
+            }
+        });
+    }
+
+    public function testMeasureCostOfCallbacksFromWorkQueue(): void
+    {
+        if (ZigImporter::$optimize === 'Debug') {
+            $this->markTestSkipped('Benchmark requires an optimized build');
+        }
+        $m = ZigImporter::load(__DIR__ . '/work-queue.zig');
+        $this->inEventLoops([ 'revolt' ], function() use($m) {
+            $results = [];
+            foreach ([ 1, 4, 16 ] as $thread_count) {
+                $m->startup($thread_count);
+                try {
+                    // callbacks from different threads arriving at the same time are handled in
+                    // one go by the main thread
+                    $callback_count = 10000;
+                    $start = hrtime(true);
+                    $total = $m->callFromThreads(fn($i) => 1, $thread_count, $callback_count);
+                    $name = "callback (work queue, $thread_count thread(s))";
+                    $results[] = self::record($name, hrtime(true) - $start, $callback_count * $thread_count, 'callback');
+                    $this->assertSame($callback_count * $thread_count, $total);
+                } finally {
+                    $m->shutdown();
+                }
+            }
+            echo "\n" . implode("\n", $results) . "\n";
+        });
+    }
+}
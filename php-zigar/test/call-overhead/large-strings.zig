@@ -0,0 +1,17 @@
+const std = @import("std");
+
+pub fn render(allocator: std.mem.Allocator, len: usize) ![]const u8 {
+    const bytes = try allocator.alloc(u8, len);
+    for (bytes, 0..) |*byte, i| byte.* = 'a' + @as(u8, @intCast(i % 26));
+    return bytes;
+}
+
+const module = @This();
+pub const @"meta(zigar)" = struct {
+    pub fn isDeclString(comptime T: type, comptime decl: std.meta.DeclEnum(T)) bool {
+        return switch (T) {
+            module => decl == .render,
+            else => false,
+        };
+    }
+};
@@ -0,0 +1,28 @@
+const std = @import("std");
+
+const zigar = @import("zigar");
+
+pub fn startup() !void {
+    try zigar.thread.use();
+}
+
+pub fn shutdown() void {
+    zigar.thread.end();
+}
+
+pub fn printLines(count: usize, promise: zigar.function.Promise(void)) !void {
+    const ns = struct {
+        fn run(n: usize, p: zigar.function.Promise(void)) void {
+            for (0..n) |i| std.debug.print("Line {d}\n", .{i});
+            // make sure every line has reached PHP by the time the promise is fulfilled
+            zigar.io.flush();
+            p.resolve({});
+        }
+    };
+    const thread = try std.Thread.spawn(.{
+        .stack_size = 1024 * 512,
+    }, ns.run, .{ count, promise });
+    thread.detach();
+}
+
+pub const getOutputStats = zigar.io.getOutputStats;
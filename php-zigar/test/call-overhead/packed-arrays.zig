@@ -0,0 +1,35 @@
+const std = @import("std");
+
+pub fn sumInts(values: []const i64) i64 {
+    var total: i64 = 0;
+    for (values) |value| total +%= value;
+    return total;
+}
+
+pub fn sumFloats(values: []const f64) f64 {
+    var total: f64 = 0;
+    for (values) |value| total += value;
+    return total;
+}
+
+pub fn scaleInts(allocator: std.mem.Allocator, values: []const i32, factor: i32) ![]i32 {
+    const result = try allocator.alloc(i32, values.len);
+    for (values, result) |value, *r| r.* = value *% factor;
+    return result;
+}
+
+pub fn scaleFloats(allocator: std.mem.Allocator, values: []const f32, factor: f32) ![]f32 {
+    const result = try allocator.alloc(f32, values.len);
+    for (values, result) |value, *r| r.* = value * factor;
+    return result;
+}
+
+const module = @This();
+pub const @"meta(zigar)" = struct {
+    pub fn isDeclPlain(comptime T: type, comptime decl: std.meta.DeclEnum(T)) bool {
+        return switch (T) {
+            module => decl == .scaleInts or decl == .scaleFloats,
+            else => false,
+        };
+    }
+};
@@ -0,0 +1,10 @@
+<?php declare(strict_types=1);
+
+// script run by the built-in web server in CallOverheadTest::testMeasureRequestsPerSecond()
+$options = [];
+$optimize = getenv('OPTIMIZE');
+if ($optimize && $optimize !== 'Debug') {
+    $options['optimize'] = $optimize;
+}
+$m = zigar_use(__DIR__ . '/request.zig', $options);
+echo $m->add(1, 2);
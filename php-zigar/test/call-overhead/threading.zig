@@ -0,0 +1,57 @@
+const std = @import("std");
+
+const zigar = @import("zigar");
+
+var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+var work_queue: zigar.thread.WorkQueue(thread_ns) = .{};
+
+pub fn startup() !void {
+    try zigar.thread.use();
+    try work_queue.init(.{
+        .allocator = gpa.allocator(),
+        .n_jobs = 1,
+    });
+}
+
+pub fn shutdown(promise: zigar.function.Promise(void)) void {
+    zigar.thread.end();
+    work_queue.deinitAsync(promise);
+}
+
+pub fn callFromThread(cb: *const fn (i32) i32, count: i32, promise: zigar.function.Promise(i32)) !void {
+    const ns = struct {
+        fn run(f: *const fn (i32) i32, n: i32, p: zigar.function.Promise(i32)) void {
+            var total: i32 = 0;
+            for (0..@intCast(n)) |i| total +%= f(@intCast(i));
+            p.resolve(total);
+        }
+    };
+    const thread = try std.Thread.spawn(.{
+        .allocator = gpa.allocator(),
+        .stack_size = 1024 * 512,
+    }, ns.run, .{ cb, count, promise });
+    thread.detach();
+}
+
+pub fn generate(count: i32, generator: zigar.function.Generator(?i32, false)) !void {
+    const ns = struct {
+        fn run(n: i32, g: zigar.function.Generator(?i32, false)) void {
+            for (0..@intCast(n)) |i| {
+                if (!g.yield(@intCast(i))) break;
+            } else g.end();
+        }
+    };
+    const thread = try std.Thread.spawn(.{
+        .allocator = gpa.allocator(),
+        .stack_size = 1024 * 512,
+    }, ns.run, .{ count, generator });
+    thread.detach();
+}
+
+pub const returnInt = work_queue.promisify(thread_ns.returnInt);
+
+const thread_ns = struct {
+    pub fn returnInt(num: i32) i32 {
+        return num;
+    }
+};
@@ -0,0 +1,40 @@
+const std = @import("std");
+
+const zigar = @import("zigar");
+
+var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+var work_queue: zigar.thread.WorkQueue(thread_ns) = .{};
+var remaining: std.atomic.Value(usize) = .init(0);
+var total: std.atomic.Value(i32) = .init(0);
+var completion: ?zigar.function.Promise(i32) = null;
+
+pub fn startup(thread_count: usize) !void {
+    try zigar.thread.use();
+    try work_queue.init(.{
+        .allocator = gpa.allocator(),
+        .n_jobs = thread_count,
+    });
+}
+
+pub fn shutdown(promise: zigar.function.Promise(void)) void {
+    zigar.thread.end();
+    work_queue.deinitAsync(promise);
+}
+
+pub fn callFromThreads(cb: *const fn (i32) i32, job_count: usize, count: i32, promise: zigar.function.Promise(i32)) !void {
+    remaining.store(job_count, .release);
+    total.store(0, .release);
+    completion = promise;
+    for (0..job_count) |_| try work_queue.push(thread_ns.callRepeatedly, .{ cb, count }, null);
+}
+
+const thread_ns = struct {
+    pub fn callRepeatedly(cb: *const fn (i32) i32, count: i32) void {
+        var sum: i32 = 0;
+        for (0..@intCast(count)) |i| sum +%= cb(@intCast(i));
+        _ = total.fetchAdd(sum, .monotonic);
+        if (remaining.fetchSub(1, .acq_rel) == 1) {
+            if (completion) |p| p.resolve(total.load(.acquire));
+        }
+    }
+};
@@ -22,6 +22,26 @@ final class OptionsTest extends ZigarTestCase
         $this->assertFalse(property_exists($m, 'c'));
     }
 
+    public function testShareStrings(): void
+    {
+        $m = ZigImporter::load(__DIR__ . '/share-strings.zig');
+        $expected = str_repeat('abcdefghijklmnopqrstuvwxyz', 1000);
+        $previous = ini_set('zigar.share_strings', '1');
+        try {
+            // string built by a growing list, shrunk at the end
+            $text = $m->getText(strlen($expected));
+            $this->assertSame($expected, $text);
+            // writable slice is copied
+            $buffer = $m->getBuffer(10000);
+            $this->assertSame(str_repeat('z', 10000), $buffer);
+            $text2 = $m->getText(100);
+            $this->assertSame(substr($expected, 0, 100), $text2);
+        } finally {
+            ini_set('zigar.share_strings', $previous);
+        }
+        $this->assertSame($expected, $m->getText(strlen($expected)));
+    }
+
     public function testDisableIoRedirection(): void
     {
         $m = ZigImporter::load(__DIR__ . '/disable-redirection.zig', [
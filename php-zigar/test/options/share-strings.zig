@@ -0,0 +1,24 @@
+const std = @import("std");
+
+pub fn getText(allocator: std.mem.Allocator, len: usize) ![]const u8 {
+    var list: std.ArrayList(u8) = .{};
+    errdefer list.deinit(allocator);
+    for (0..len) |i| try list.append(allocator, 'a' + @as(u8, @intCast(i % 26)));
+    return try list.toOwnedSlice(allocator);
+}
+
+pub fn getBuffer(allocator: std.mem.Allocator, len: usize) ![]u8 {
+    const bytes = try allocator.alloc(u8, len);
+    @memset(bytes, 'z');
+    return bytes;
+}
+
+const module = @This();
+pub const @"meta(zigar)" = struct {
+    pub fn isDeclString(comptime T: type, comptime decl: std.meta.DeclEnum(T)) bool {
+        return switch (T) {
+            module => decl == .getText or decl == .getBuffer,
+            else => false,
+        };
+    }
+};
@@ -43,4 +43,28 @@ final class OutputTest extends ZigarTestCase
         $m->test_write();
         $m->test_perror();
     }
+
+    public function testPrintFromThreadInOrder(): void
+    {
+        if (PHP_OS_FAMILY === 'Windows') {
+            $this->markTestSkipped('Test requires writev()');
+        }
+        $m = ZigImporter::load(__DIR__ . '/print-from-thread.zig');
+        $this->inEventLoops([ 'revolt' ], function() use($m) {
+            $m->startup();
+            try {
+                $this->expectOutput(<<<OUTPUT
+                Line 1
+                Line 2
+                Line 3
+                Line 4
+                Line 5
+
+                OUTPUT);
+                $m->print();
+            } finally {
+                $m->shutdown();
+            }
+        });
+    }
 }
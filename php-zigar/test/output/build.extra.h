@@ -50,3 +50,8 @@ void test_perror(void) {
     fopen("...", "r");
     perror("Hello");
 }
+
+void test_printf_then_fflush(const char *s) {
+    printf("%s", s);
+    fflush(NULL);
+}
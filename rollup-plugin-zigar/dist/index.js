@@ -11,9 +11,15 @@ export const schema = {
   properties: {
     ...optionsForCompile,
     ...optionsForTranspile,
+    detectUsedExports: {
+      type: 'boolean',
+      title: 'Omit declarations of Zig modules that are not imported by other modules',
+    },
   },
 };
 
+const extensionsRegex = /\.(zig|zigar)(\?|$)/;
+
 export function verifyOptions(options, schema) {
   for (const [ name, value ] of Object.entries(options)) {
     const descriptor = schema.properties[name];
@@ -42,6 +48,7 @@ export default function createPlugin(options = {}) {
   let serving = false;
   let optimizeDefault = getOptimizationMode(process.env.NODE_ENV === 'production');
   const wasmBinaries = {};
+  const importLists = new Map();
   return {
     name: 'zigar',
     /* c8 ignore next 7 */
@@ -63,14 +70,23 @@ export default function createPlugin(options = {}) {
         }
       })
     },
+    moduleParsed(info) {
+      if (!serving && options.detectUsedExports !== false && !extensionsRegex.test(info.id)) {
+        importLists.set(info.id, findImports(this, info));
+      }
+    },
     async load(id) {
       if (id.endsWith('.zig') || id.endsWith('.zigar')) {
         const {
           nodeCompat = false,
           embedWASM = false,
           optimize = optimizeDefault,
+          detectUsedExports = true,
           ...otherOptions
         } = options;
+        if (!serving && detectUsedExports && !otherOptions.usedExports) {
+          otherOptions.usedExports = await findUsedExports(this, id, importLists);
+        }
         const wasmLoader = async (path, dv) => {
           const source = new Uint8Array(dv.buffer, dv.byteOffset, dv.byteLength);
           const name = parse(path).name + '.wasm';
@@ -88,13 +104,19 @@ export default function createPlugin(options = {}) {
             }
           }
         };
-        const { code, exports, structures, sourcePaths } = await transpile(id, {
+        const { code, exports, structures, sourcePaths, sizeReport } = await transpile(id, {
           ...otherOptions,
           optimize,
           nodeCompat,
           wasmLoader,
           embedWASM,
         });
+        if (otherOptions.usedExports && sizeReport) {
+          const { binarySize, strippedSize } = sizeReport;
+          const names = otherOptions.usedExports.join(', ') || 'none';
+          this.info(`${parse(id).base}: exported ${names} (WASM ${formatSize(binarySize)}`
+                  + ((strippedSize !== binarySize) ? `, ${formatSize(strippedSize)} after stripping)` : ')'));
+        }
         const meta = {
           zigar: { exports, structures, sourcePaths },
         };
@@ -111,6 +133,158 @@ export default function createPlugin(options = {}) {
   };
 }
 
+function findImports(ctx, info) {
+  // list modules imported by the given module, along with the names being imported; names is
+  // null when everything could be used (namespace import, dynamic import, etc.)
+  const imports = [];
+  let dynamicCount = 0;
+  const add = (source, names) => {
+    if (typeof(source) !== 'string') return;
+    const entry = imports.find(i => i.source === source);
+    if (!entry) {
+      imports.push({ source, names });
+    } else if (entry.names) {
+      entry.names = (names) ? [ ...entry.names, ...names ] : null;
+    }
+  };
+  const visit = (node) => {
+    if (Array.isArray(node)) {
+      for (const child of node) visit(child);
+      return;
+    } else if (!node || typeof(node.type) !== 'string') {
+      return;
+    }
+    switch (node.type) {
+      case 'ImportDeclaration': {
+        const names = [];
+        for (const specifier of node.specifiers) {
+          const name = (specifier.type === 'ImportSpecifier') ? getName(specifier.imported) : 'default';
+          names.push(name);
+        }
+        add(node.source.value, names.includes('default') ? null : names);
+        return;
+      }
+      case 'ExportNamedDeclaration':
+        if (node.source) {
+          const names = node.specifiers.map(s => getName(s.local));
+          add(node.source.value, names.includes('default') ? null : names);
+          return;
+        }
+        break;
+      case 'ExportAllDeclaration':
+        add(node.source.value, null);
+        return;
+      case 'ImportExpression':
+        if (node.source.type === 'Literal') {
+          add(node.source.value, null);
+          dynamicCount++;
+        }
+        break;
+    }
+    for (const [ key, value ] of Object.entries(node)) {
+      if (key !== 'type' && value && typeof(value) === 'object') {
+        visit(value);
+      }
+    }
+  };
+  let ast;
+  try {
+    ast = info.ast ?? ctx.parse(info.code);
+  } catch (err) {
+  }
+  if (!ast) {
+    return Promise.resolve(null);
+  }
+  visit(ast.body);
+  const staticCount = imports.length - dynamicCount;
+  return (async () => {
+    // resolve the paths to Zig modules
+    const zigImports = [];
+    for (const { source, names } of imports) {
+      if (extensionsRegex.test(source)) {
+        const resolved = await ctx.resolve(source, info.id);
+        if (resolved) {
+          zigImports.push({ id: resolved.id, names });
+        }
+      }
+    }
+    return { zigImports, staticCount };
+  })();
+}
+
+function getName(node) {
+  return (node.type === 'Identifier') ? node.name : node.value;
+}
+
+async function findUsedExports(ctx, id, importLists) {
+  // a Zig module cannot import other modules, so all other modules importing it will eventually
+  // get parsed while we're waiting here; we know that's happened when the module graph stops 
+  // growing
+  const timeLimit = 2000;
+  let lastChange = performance.now();
+  let lastState = '';
+  let stableCount = 0;
+  while (stableCount < 3) {
+    await new Promise(r => setTimeout(r, 10));
+    let pending = 0;
+    const ids = [ ...ctx.getModuleIds() ];
+    for (const moduleId of ids) {
+      const info = ctx.getModuleInfo(moduleId);
+      if (!info || info.isExternal || extensionsRegex.test(moduleId)) continue;
+      const list = importLists.get(moduleId);
+      if (!list) {
+        pending++;
+      } else {
+        const result = await list;
+        if (!result) {
+          // module could not be parsed
+          return;
+        }
+        // wait for dependencies to be resolved
+        if (info.importedIds.length < result.staticCount) {
+          pending++;
+        }
+      }
+    }
+    const state = `${ids.length}:${pending}`;
+    if (state !== lastState) {
+      lastState = state;
+      lastChange = performance.now();
+      stableCount = 0;
+    } else if (pending === 0) {
+      stableCount++;
+    } else if (performance.now() - lastChange > timeLimit) {
+      // give up, something might be waiting for this module
+      return;
+    }
+  }
+  if (ctx.getModuleInfo(id)?.isEntry) {
+    // everything is exported by the bundle
+    return;
+  }
+  const names = new Set();
+  for (const moduleId of ctx.getModuleIds()) {
+    const { zigImports } = await importLists.get(moduleId) ?? {};
+    for (const zigImport of zigImports ?? []) {
+      if (zigImport.id === id) {
+        if (!zigImport.names) {
+          return;
+        }
+        for (const name of zigImport.names) {
+          names.add(name);
+        }
+      }
+    }
+  }
+  return [ ...names ];
+}
+
+function formatSize(size) {
+  return (size >= 1024 * 1024) 
+  ? `${(size / 1024 / 1024).toFixed(1)} MB` 
+  : `${(size / 1024).toFixed(1)} KB`;
+}
+
 function fetchWASM(refID) {
   return `(async () => {
   const url = import.meta.ROLLUP_FILE_URL_${refID};
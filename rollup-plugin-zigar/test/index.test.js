@@ -94,6 +94,30 @@ describe('Loader', function() {
       server.close();
     })
   })
+  describe('Tree-shaking', function() {
+    const path = absolute('./tree-shaking/main.js');
+    it('should omit functions that are not imported', async function() {
+      const options = { embedWASM: true, optimize: 'ReleaseSmall' };
+      const moduleCode = await transform(path, options);
+      expect(moduleCode).to.match(/\bv\d+ as add,/);
+      expect(moduleCode).to.not.match(/ as multiply,/);
+      expect(moduleCode).to.not.match(/ as divide,/);
+      const code = await transpile(path, options);
+      expect(code).to.not.contain('multiply');
+      expect(code).to.not.contain('divide');
+    })
+    it('should produce smaller code than when detection is disabled', async function() {
+      const code1 = await transpile(path, { embedWASM: true, optimize: 'ReleaseSmall' });
+      const code2 = await transpile(path, { embedWASM: true, optimize: 'ReleaseSmall', detectUsedExports: false });
+      expect(code2).to.contain('multiply');
+      expect(code1.length).to.be.below(code2.length);
+    })
+    it('should keep all functions when module is imported as namespace', async function() {
+      const path = absolute('./tree-shaking/namespace.js');
+      const code = await transpile(path, { embedWASM: true, optimize: 'ReleaseSmall' });
+      expect(code).to.contain('multiply');
+    })
+  })
 })
 
 async function transpile(path, options = {}) {
@@ -122,6 +146,26 @@ async function transpile(path, options = {}) {
   return code;
 }
 
+async function transform(path, options = {}) {
+  // return code generated for the Zig module, before it gets merged into the bundle
+  const inputOptions = {
+    input: path,
+    plugins: [
+      Zigar(options),
+      NodeResolve({
+        modulePaths: [ absolute(`../node_modules`) ],
+      }),
+    ],
+  };
+  const bundle = await rollup(inputOptions);
+  try {
+    const module = bundle.cache.modules.find(m => /\.(zig|zigar)(\?|$)/.test(m.id));
+    return module.code;
+  } finally {
+    await bundle.close();
+  }
+}
+
 async function sha1(text) {
   const { createHash } = await import('crypto');
   const hash = createHash('sha1');
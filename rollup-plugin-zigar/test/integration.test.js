@@ -34,6 +34,9 @@ async function importModule(url, options) {
     omitFunctions = false,
     omitVariables = false,
     maxMemory = undefined,
+    lazyStructures = false,
+    binaryMetadata = false,
+    metrics = false,
   } = options;
   if (currentModule) {
     await currentModule.__zigar?.abandon();
@@ -65,6 +68,9 @@ async function importModule(url, options) {
         omitFunctions,
         omitVariables,
         maxMemory,
+        lazyStructures,
+        binaryMetadata,
+        metrics,
       }),
       NodeResolve({
         modulePaths: [ resolve(`../node_modules`) ],
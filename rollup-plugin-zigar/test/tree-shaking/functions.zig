@@ -0,0 +1,11 @@
+pub fn add(a: i32, b: i32) i32 {
+    return a + b;
+}
+
+pub fn multiply(a: i32, b: i32) i32 {
+    return a * b;
+}
+
+pub fn divide(a: i32, b: i32) i32 {
+    return @divTrunc(a, b);
+}
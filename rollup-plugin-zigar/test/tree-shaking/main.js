@@ -0,0 +1,3 @@
+import { add } from './functions.zig';
+
+console.log(add(1, 2));
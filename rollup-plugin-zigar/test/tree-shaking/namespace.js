@@ -0,0 +1,3 @@
+import * as functions from './functions.zig';
+
+console.log(functions.multiply(1, 2));
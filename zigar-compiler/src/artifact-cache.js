@@ -0,0 +1,183 @@
+import { execFile } from 'node:child_process';
+import { createHash } from 'node:crypto';
+import { constants } from 'node:fs';
+import { copyFile, readFile, rename, stat, writeFile } from 'node:fs/promises';
+import { basename, dirname, isAbsolute, join, relative, resolve, sep } from 'node:path';
+import { promisify } from 'node:util';
+import { createDirectory, deleteFile, loadFile, sha1 } from './utility-functions.js';
+
+const execFileAsync = promisify(execFile);
+
+// number of distinct source closures remembered for a module
+const maxClosureCount = 8;
+
+const stats = {
+  hits: 0,
+  misses: 0,
+  stores: 0,
+  errors: 0,
+};
+
+export function getArtifactCacheStats() {
+  return { ...stats };
+}
+
+export function resetArtifactCacheStats() {
+  for (const key of Object.keys(stats)) {
+    stats[key] = 0;
+  }
+}
+
+const zigEnvs = {};
+
+export async function getZigEnv(zigPath) {
+  let env = zigEnvs[zigPath];
+  if (!env) {
+    env = zigEnvs[zigPath] = (async () => {
+      const { stdout } = await execFileAsync(zigPath, [ 'env' ], { windowsHide: true });
+      // older versions of Zig output JSON while newer ones output ZON
+      const get = (name) => {
+        const re = new RegExp(`"?\\.?${name}"?\\s*[:=]\\s*"((?:[^"\\\\]|\\\\.)*)"`);
+        const m = re.exec(stdout);
+        return (m) ? JSON.parse(`"${m[1]}"`) : undefined;
+      };
+      return { version: get('version'), libDir: get('lib_dir') };
+    })();
+    env.catch(() => delete zigEnvs[zigPath]);
+  }
+  return env;
+}
+
+function getConfigFingerprint(config, zigEnv) {
+  const fields = [
+    'moduleName', 'platform', 'arch', 'optimize', 'zigArgs', 'useLibc', 'useLLVM',
+    'usePthreadEmulation', 'useRedirection', 'isWASM', 'multithreaded', 'stackSize', 'maxMemory',
+    'evalBranchQuota', 'omitFunctions', 'omitVariables', 'usedExports',
+  ];
+  const values = { zigVersion: zigEnv.version };
+  for (const name of fields) {
+    values[name] = config[name] ?? null;
+  }
+  return JSON.stringify(values);
+}
+
+function getManifestPath(cacheDir, fingerprint) {
+  return join(cacheDir, 'manifests', `${sha1(fingerprint)}.json`);
+}
+
+function getArtifactPath(cacheDir, key, outputPath) {
+  return join(cacheDir, 'artifacts', key.slice(0, 2), key, basename(outputPath));
+}
+
+async function hashClosure(config, fingerprint, closure) {
+  // paths are relative to the module's directory so that different checkouts of the same
+  // project would produce the same key
+  const hash = createHash('sha1');
+  hash.update(fingerprint);
+  for (const path of closure) {
+    const data = await readFile(resolve(config.moduleDir, path));
+    hash.update(`\0${path}\0${data.length}\0`);
+    hash.update(data);
+  }
+  return hash.digest('hex');
+}
+
+async function hashFile(path) {
+  const hash = createHash('sha1');
+  hash.update(await readFile(path));
+  return hash.digest('hex');
+}
+
+export async function restoreArtifact(cacheDir, config) {
+  try {
+    const zigEnv = await getZigEnv(config.zigPath);
+    const fingerprint = getConfigFingerprint(config, zigEnv);
+    const manifestPath = getManifestPath(cacheDir, fingerprint);
+    const manifest = JSON.parse(await loadFile(manifestPath, '{}'));
+    for (const { sources, artifactHash } of manifest.closures ?? []) {
+      let key;
+      try {
+        key = await hashClosure(config, fingerprint, sources);
+      } catch (err) {
+        // source file no longer exists
+        continue;
+      }
+      const artifactPath = getArtifactPath(cacheDir, key, config.outputPath);
+      try {
+        await stat(artifactPath);
+      } catch (err) {
+        continue;
+      }
+      // leave the output file alone if it's identical
+      let current;
+      try {
+        current = await hashFile(config.outputPath);
+      } catch (err) {
+      }
+      if (current !== artifactHash) {
+        await createDirectory(dirname(config.outputPath));
+        // use copy-on-write when the file system supports it
+        await copyFile(artifactPath, config.outputPath, constants.COPYFILE_FICLONE);
+      }
+      const sourcePaths = sources.map(p => resolve(config.moduleDir, p));
+      stats.hits++;
+      return { sourcePaths };
+    }
+  } catch (err) {
+    stats.errors++;
+  }
+  stats.misses++;
+  return null;
+}
+
+export async function storeArtifact(cacheDir, config, sourcePaths) {
+  try {
+    const zigEnv = await getZigEnv(config.zigPath);
+    const fingerprint = getConfigFingerprint(config, zigEnv);
+    const libDir = (zigEnv.libDir) ? resolve(zigEnv.libDir) + sep : null;
+    // files from the standard library are covered by the version number
+    const closure = [
+      ...sourcePaths,
+      config.buildFilePath,
+      config.packageConfigPath,
+      // build.extra.zig is copied into the build directory, so it doesn't show up among the sources
+      config.extraFilePath,
+      config.cHeaderPath,
+    ]
+      .filter(p => !!p && !(libDir && resolve(p).startsWith(libDir)))
+      .map(p => relative(config.moduleDir, p))
+      .filter((p, i, list) => list.indexOf(p) === i && !isAbsolute(p))
+      .sort();
+    const key = await hashClosure(config, fingerprint, closure);
+    const artifactPath = getArtifactPath(cacheDir, key, config.outputPath);
+    const artifactHash = await hashFile(config.outputPath);
+    await createDirectory(dirname(artifactPath));
+    // write to temporary file first so other processes would never see a partial file
+    const tempPath = `${artifactPath}.${process.pid}.tmp`;
+    try {
+      await copyFile(config.outputPath, tempPath, constants.COPYFILE_FICLONE);
+      await rename(tempPath, artifactPath);
+    } finally {
+      await deleteFile(tempPath);
+    }
+    const manifestPath = getManifestPath(cacheDir, fingerprint);
+    const manifest = JSON.parse(await loadFile(manifestPath, '{}'));
+    const closures = (manifest.closures ?? []).filter(c => c.sources.join('\n') !== closure.join('\n'));
+    closures.unshift({ sources: closure, artifactHash });
+    closures.splice(maxClosureCount);
+    await createDirectory(dirname(manifestPath));
+    const manifestTempPath = `${manifestPath}.${process.pid}.tmp`;
+    try {
+      await writeFile(manifestTempPath, JSON.stringify({ closures }, undefined, 2));
+      await rename(manifestTempPath, manifestPath);
+    } finally {
+      await deleteFile(manifestTempPath);
+    }
+    stats.stores++;
+    return true;
+  } catch (err) {
+    stats.errors++;
+    return false;
+  }
+}
+
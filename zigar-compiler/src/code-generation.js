@@ -4,6 +4,7 @@ import {
 } from '../../zigar-runtime/src/constants.js';
 import { MEMORY, SLOTS } from '../../zigar-runtime/src/symbols.js';
 import { findObjects } from '../../zigar-runtime/src/utils.js';
+import { encodeStructures } from './metadata-encoding.js';
 import { getArch, getLibraryExt, getPlatform } from './utility-functions.js';
 
 export function generateCode(definition, params) {
@@ -17,6 +18,8 @@ export function generateCode(definition, params) {
     moduleOptions,
     envVariables = {},
     standaloneLoader,
+    lazyStructures = false,
+    binaryMetadata = false,
   } = params;
   const exports = getExports(structures);
   const lines = [];
@@ -50,8 +53,10 @@ export function generateCode(definition, params) {
   for (const mixinPath of mixinPaths) {
     add(`import '${runtimeURL}/${mixinPath}';`);
   }
-  // write out the structures as object literals
-  addStructureDefinitions(lines, definition);
+  if (!binaryMetadata) {
+    // write out the structures as object literals
+    addStructureDefinitions(lines, definition);
+  }
   if (Object.keys(envVariables).length > 0) {
     add(`\n// set environment variables`);
     for (const [ name, value ] of Object.entries(envVariables)) {
@@ -60,8 +65,18 @@ export function generateCode(definition, params) {
   }
   add(`\n// create runtime environment`);
   add(`const env = createEnvironment();`);
-  add(`\n// recreate structures`);
-  add(`env.recreateStructures(structures, settings);`);
+  if (binaryMetadata) {
+    const base64 = encodeStructures(definition).toString('base64');
+    add(`\n// decode structures`);
+    add(`const { structures, root, settings } = env.decodeStructures(${JSON.stringify(base64)});`);
+  }
+  if (lazyStructures) {
+    add(`\n// recreate structures when they're first used`);
+    add(`env.recreateStructures(structures, settings, true);`);
+  } else {
+    add(`\n// recreate structures`);
+    add(`env.recreateStructures(structures, settings);`);
+  }
   if (binarySource) {
     if (moduleOptions) {
       add(`\n// initiate loading and compilation of WASM bytecodes`);
@@ -5,6 +5,7 @@ import os from 'node:os';
 import { basename, dirname, isAbsolute, join, parse, sep } from 'node:path';
 import { fileURLToPath, URL } from 'node:url';
 import { promisify } from 'node:util';
+import { restoreArtifact, storeArtifact } from './artifact-cache.js';
 import {
   acquireLock, copyFile, copyZonFile, createDirectory, deleteDirectory, deleteFile, getArch,
   getDirectoryStats, getLibraryExt, getPlatform, releaseLock, sha1
@@ -36,9 +37,11 @@ export async function compile(srcPath, modPath, options) {
   const config = await createConfig(srcPath, modPath, options);
   const { outputPath } = config;
   let changed = false;
+  let cached = false;
   let sourcePaths = [];
   if (srcPath) {
     const { zigPath, zigArgs, moduleBuildDir, pdbPath, optimize } = config;
+    const { artifactCacheDir } = options;
     // only one process can compile a given file at a time
     const pidPath = `${moduleBuildDir}.pid`;
     await acquireLock(pidPath);
@@ -50,13 +53,27 @@ export async function compile(srcPath, modPath, options) {
       }
     };
     const outputMTimeBefore = await getOutputMTime();
+    let restored = null;
+    let built = false;
     try {
       if (!outputMTimeBefore || options.recompile !== false) {
-        const { onStart, onEnd } = options;
-        // create config file
-        await createProject(config);
-        // then run the compiler
-        await runCompiler(zigPath, zigArgs, { cwd: moduleBuildDir, onStart, onEnd });
+        if (artifactCacheDir) {
+          // see if the same build has been performed before
+          restored = await restoreArtifact(artifactCacheDir, config);
+        }
+        if (!restored) {
+          const { onStart, onEnd, maxConcurrentBuilds } = options;
+          // create config file
+          await createProject(config);
+          // then run the compiler
+          await runCompiler(zigPath, zigArgs, {
+            cwd: moduleBuildDir,
+            onStart,
+            onEnd,
+            maxConcurrentBuilds,
+          });
+          built = true;
+        }
       }
     } catch(err) {
       if (err.code === 'ENOENT') {
@@ -67,8 +84,16 @@ export async function compile(srcPath, modPath, options) {
         throw err;
       }
     } finally {
-      // get list of files involved in build
-      sourcePaths = await findSourcePaths(moduleBuildDir);
+      if (restored) {
+        sourcePaths = restored.sourcePaths;
+        cached = true;
+      } else {
+        // get list of files involved in build
+        sourcePaths = await findSourcePaths(moduleBuildDir);
+        if (built && artifactCacheDir) {
+          await storeArtifact(artifactCacheDir, config, sourcePaths);
+        }
+      }
       if (config.clean) {
         await deleteDirectory(moduleBuildDir);
       }
@@ -79,23 +104,42 @@ export async function compile(srcPath, modPath, options) {
       cleanBuildDirectory(config).catch(() => {});
     }
     const outputMTimeAfter = await getOutputMTime();
-    changed = outputMTimeBefore !== outputMTimeAfter;  
-    sourcePaths.push(config.buildFilePath);
-    if (config.packageConfigPath) {
+    changed = outputMTimeBefore !== outputMTimeAfter;
+    if (!sourcePaths.includes(config.buildFilePath)) {
+      sourcePaths.push(config.buildFilePath);
+    }
+    if (config.packageConfigPath && !sourcePaths.includes(config.packageConfigPath)) {
       sourcePaths.push(config.packageConfigPath);
     }
   }
-  return { outputPath, changed, sourcePaths }
+  return { outputPath, changed, cached, sourcePaths }
+}
+
+let activeBuildCount = 0;
+const pendingBuilds = [];
+
+async function acquireBuildSlot(max) {
+  if (activeBuildCount < max) {
+    activeBuildCount++;
+  } else {
+    // wait for a slot to be handed over by releaseBuildSlot()
+    await new Promise(resolve => pendingBuilds.push(resolve));
+  }
 }
 
-let lock = null;
+function releaseBuildSlot() {
+  const next = pendingBuilds.shift();
+  if (next) {
+    // pass the slot directly to the next build in line
+    next();
+  } else {
+    activeBuildCount--;
+  }
+}
 
-async function getLock() {
-  const previous = lock;  
-  let unlock;
-  lock = new Promise(resolve => unlock = resolve);
-  await previous;
-  return unlock;
+export function getDefaultBuildConcurrency() {
+  /* c8 ignore next */
+  return os.availableParallelism?.() ?? os.cpus().length ?? 1;
 }
 
 export async function runCompiler(path, args, options) {
@@ -103,8 +147,11 @@ export async function runCompiler(path, args, options) {
     cwd,
     onStart,
     onEnd,
+    maxConcurrentBuilds = getDefaultBuildConcurrency(),
   } = options;
-  const unlock = await getLock();
+  // builds of different modules can run in parallel; builds of the same module are serialized
+  // by the pid lock acquired in compile()
+  await acquireBuildSlot(Math.max(1, maxConcurrentBuilds));
   try {
     onStart?.();
     await execFileAsync(path, args, { cwd, windowsHide: true });
@@ -112,7 +159,7 @@ export async function runCompiler(path, args, options) {
     throw new CompilationError(path, args, cwd, err);
     /* c8 ignore next */
   } finally {
-    unlock();
+    releaseBuildSlot();
     onEnd?.();
   }
 }
@@ -148,11 +195,18 @@ export function formatProjectConfig(config) {
     'moduleName', 'modulePath', 'moduleDir', 'outputPath', 'pdbPath', 'zigarSrcPath',
     'cHeaderPath', 'useLibc', 'useLLVM', 'usePthreadEmulation', 'useRedirection', 'isWASM',
     'multithreaded', 'stackSize', 'maxMemory', 'evalBranchQuota', 'omitFunctions', 'omitVariables',
+    'usedExports',
   ];
   for (const [ name, value ] of Object.entries(config)) {
     if (fields.includes(name)) {
       const snakeCase = name.replace(/[A-Z]+/g, m => '_' + m.toLowerCase());
-      lines.push(`pub const ${snakeCase} = ${JSON.stringify(value ?? null)};`);
+      if (name === 'usedExports') {
+        // list of strings needs to be in Zig syntax
+        const list = (value) ? `&.{ ${value.map(n => JSON.stringify(n)).join(', ')} }` : 'null';
+        lines.push(`pub const ${snakeCase}: ?[]const []const u8 = ${list};`);
+      } else {
+        lines.push(`pub const ${snakeCase} = ${JSON.stringify(value ?? null)};`);
+      }
     }
   }
   return lines.join('\n') + '\n';
@@ -228,6 +282,7 @@ export async function createConfig(srcPath, modPath, options = {}) {
     evalBranchQuota = 2000000,
     omitFunctions = false,
     omitVariables = false,
+    usedExports = null,
     ignoreBuildFile = false,
   } = options;
   const src = parse(srcPath ?? '');
@@ -344,6 +399,7 @@ export async function createConfig(srcPath, modPath, options = {}) {
     evalBranchQuota,
     omitFunctions,
     omitVariables,
+    usedExports: (usedExports) ? [ ...usedExports ].sort() : null,
     ignoreBuildFile,
     extraFilePath,
   };
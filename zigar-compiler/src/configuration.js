@@ -16,6 +16,10 @@ export const optionsForCompile = {
     type: 'boolean',
     title: 'Omit all variables',
   },
+  usedExports: {
+    type: 'object',
+    title: 'Names of declarations in the root module that are used; others are omitted',
+  },
   omitExports: {
     type: 'boolean',
     title: 'Omit export statements',
@@ -52,6 +56,14 @@ export const optionsForCompile = {
     type: 'string',
     title: 'Directory where compiled library files are placed',
   },
+  artifactCacheDir: {
+    type: 'string',
+    title: 'Directory where built libraries are shared between checkouts, keyed by source content',
+  },
+  structureSnapshot: {
+    type: 'boolean',
+    title: 'Save structures exported by native library in a file next to it for faster loading',
+  },
   zigPath: {
     type: 'string',
     title: 'Zig command used to build libraries',
@@ -80,6 +92,10 @@ export const optionsForCompile = {
     type: 'boolean',
     title: 'Remove temporary build directory after compilation finishes',
   },
+  maxConcurrentBuilds: {
+    type: 'number',
+    title: 'Maximum number of Zig builds that can run at the same time',
+  },
   targets: {
     type: 'object',
     title: 'List of cross-compilation targets',
@@ -99,6 +115,14 @@ export const optionsForTranspile = {
     type: 'boolean',
     title: 'Embed WASM file in JavaScript source code',
   },
+  compressWASM: {
+    type: 'boolean',
+    title: 'Compress embedded WASM file, decompressing it while it is being compiled',
+  },
+  reportEmbedding: {
+    type: 'boolean',
+    title: 'Report size and startup time of each WASM embedding mode',
+  },
   stripWASM: {
     type: 'boolean',
     title: 'Remove unnecessary code from WASM file',
@@ -119,6 +143,22 @@ export const optionsForTranspile = {
     type: 'boolean',
     title: 'Provide emulated pthread functions',
   },
+  workerPoolSize: {
+    type: 'number',
+    title: 'Number of idle web workers kept ready for running threads',
+  },
+  lazyStructures: {
+    type: 'boolean',
+    title: 'Define structures only when they are first used',
+  },
+  binaryMetadata: {
+    type: 'boolean',
+    title: 'Store structure definitions in binary form instead of as object literals',
+  },
+  metrics: {
+    type: 'boolean',
+    title: 'Include support for gathering call metrics',
+  },
 };
 
 const allOptions = {
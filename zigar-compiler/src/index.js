@@ -1,3 +1,4 @@
+export { getArtifactCacheStats } from './artifact-cache.js';
 export { generateCode } from './code-generation.js';
 export { compile, getCachePath, getModuleCachePath, test } from './compilation.js';
 export {
@@ -5,5 +6,6 @@ export {
   optionsForTranspile, processConfig
 } from './configuration.js';
 export { hideStatus, showResult, showStatus } from './status.js';
+export { getSnapshotKey, loadStructureSnapshot, saveStructureSnapshot } from './structure-snapshot.js';
 export { getArch, getLibraryExt, getPlatform, normalizePath } from './utility-functions.js';
 
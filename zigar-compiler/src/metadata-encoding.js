@@ -0,0 +1,237 @@
+import { MetadataTag, metadataMagic } from '../../zigar-runtime/src/constants.js';
+import { MEMORY, SLOTS } from '../../zigar-runtime/src/symbols.js';
+import { findObjects } from '../../zigar-runtime/src/utils.js';
+
+// Layout (integers are unsigned LEB128):
+//   magic and version (4 bytes)
+//   string count, then length and UTF-8 bytes of each string
+//   buffer count, then length and content of each buffer
+//   structure count, object count
+//   fields of each structure, fields of each object, settings (all as tagged values)
+//   index of the root structure
+//
+// Keys of records and string values are stored as indices into the string table. Structures,
+// objects, and buffers are referenced by index.
+export function encodeStructures(definition) {
+  const { structures, settings } = definition;
+  const structureIndices = new Map();
+  const structureMap = new Map();
+  for (const [ index, structure ] of structures.entries()) {
+    structureIndices.set(structure, index);
+    structureMap.set(structure.constructor, structure);
+  }
+  const objects = findObjects(structures, SLOTS);
+  const objectIndices = new Map();
+  for (const [ index, object ] of objects.entries()) {
+    objectIndices.set(object, index);
+  }
+  const strings = [];
+  const stringIndices = new Map();
+  const getStringIndex = (s) => {
+    let index = stringIndices.get(s);
+    if (index === undefined) {
+      index = strings.length;
+      strings.push(s);
+      stringIndices.set(s, index);
+    }
+    return index;
+  };
+  // buffers with identical content are stored only once
+  const buffers = [];
+  const bufferIndices = new Map();
+  const bufferContents = new Map();
+  const emptyBuffer = new ArrayBuffer(0);
+  const getBufferIndex = (buffer) => {
+    let index = bufferIndices.get(buffer);
+    if (index === undefined) {
+      const content = Buffer.from(buffer);
+      const key = content.toString('base64');
+      index = bufferContents.get(key);
+      if (index === undefined) {
+        index = buffers.length;
+        buffers.push(content);
+        bufferContents.set(key, index);
+      }
+      bufferIndices.set(buffer, index);
+    }
+    return index;
+  };
+  const body = new ByteWriter();
+  const writeValue = (value) => {
+    switch (typeof(value)) {
+      case 'undefined':
+        body.writeByte(MetadataTag.Undefined);
+        return;
+      case 'boolean':
+        body.writeByte(value ? MetadataTag.True : MetadataTag.False);
+        return;
+      case 'number':
+        if (Number.isSafeInteger(value) && !Object.is(value, -0)) {
+          body.writeByte(value >= 0 ? MetadataTag.Uint : MetadataTag.NegativeInt);
+          body.writeUint(Math.abs(value));
+        } else {
+          body.writeByte(MetadataTag.Float);
+          body.writeFloat(value);
+        }
+        return;
+      case 'string':
+        body.writeByte(MetadataTag.String);
+        body.writeUint(getStringIndex(value));
+        return;
+      case 'bigint':
+        body.writeByte(value >= 0n ? MetadataTag.BigInt : MetadataTag.NegativeBigInt);
+        body.writeBigUint(value >= 0n ? value : -value);
+        return;
+    }
+    if (value === null) {
+      body.writeByte(MetadataTag.Null);
+    } else if (structureIndices.has(value)) {
+      body.writeByte(MetadataTag.StructureRef);
+      body.writeUint(structureIndices.get(value));
+    } else if (objectIndices.has(value)) {
+      body.writeByte(MetadataTag.ObjectRef);
+      body.writeUint(objectIndices.get(value));
+    } else if (value instanceof ArrayBuffer) {
+      body.writeByte(MetadataTag.BufferRef);
+      body.writeUint(getBufferIndex(value));
+    } else if (Array.isArray(value)) {
+      body.writeByte(MetadataTag.Array);
+      body.writeUint(value.length);
+      for (const item of value) {
+        writeValue(item);
+      }
+    } else {
+      writeRecord(Object.entries(value));
+    }
+  };
+  const writeRecord = (entries) => {
+    body.writeByte(MetadataTag.Record);
+    body.writeUint(entries.length);
+    for (const [ key, value ] of entries) {
+      body.writeUint(getStringIndex(key));
+      writeValue(value);
+    }
+  };
+  for (const structure of structures) {
+    const entries = [];
+    for (const [ name, value ] of Object.entries(structure)) {
+      switch (name) {
+        case 'constructor':
+        case 'typedArray':
+        case 'sentinel':
+          break;
+        default:
+          entries.push([ name, value ]);
+      }
+    }
+    writeRecord(entries);
+  }
+  for (const object of objects) {
+    const { [MEMORY]: dv, [SLOTS]: slots } = object;
+    const entries = [];
+    const structure = structureMap.get(object.constructor);
+    if (structure) {
+      entries.push([ 'structure', structure ]);
+    }
+    if (dv) {
+      const buffer = (dv.buffer.byteLength > 0) ? dv.buffer : emptyBuffer;
+      const memory = { array: buffer };
+      if (dv.byteLength < buffer.byteLength) {
+        memory.offset = dv.byteOffset;
+        memory.length = dv.byteLength;
+      }
+      entries.push([ 'memory', memory ]);
+      if (dv.handle !== undefined) {
+        entries.push([ 'handle', dv.handle ]);
+      }
+    }
+    if (slots) {
+      const children = {};
+      let found = false;
+      for (const [ slot, child ] of Object.entries(slots)) {
+        if (objectIndices.has(child)) {
+          children[slot] = child;
+          found = true;
+        }
+      }
+      if (found) {
+        entries.push([ 'slots', children ]);
+      }
+    }
+    writeRecord(entries);
+  }
+  writeValue(settings);
+  body.writeUint(structures.length - 1);
+  const header = new ByteWriter();
+  for (const byte of metadataMagic) {
+    header.writeByte(byte);
+  }
+  header.writeUint(strings.length);
+  for (const s of strings) {
+    header.writeBytes(Buffer.from(s, 'utf-8'), true);
+  }
+  header.writeUint(buffers.length);
+  for (const content of buffers) {
+    header.writeBytes(content, true);
+  }
+  header.writeUint(structures.length);
+  header.writeUint(objects.length);
+  return Buffer.concat([ header.getBytes(), body.getBytes() ]);
+}
+
+class ByteWriter {
+  chunks = [];
+  bytes = [];
+
+  writeByte(byte) {
+    this.bytes.push(byte);
+  }
+
+  writeUint(value) {
+    do {
+      let byte = value % 128;
+      value = Math.floor(value / 128);
+      if (value > 0) {
+        byte |= 0x80;
+      }
+      this.bytes.push(byte);
+    } while (value > 0);
+  }
+
+  writeBigUint(value) {
+    do {
+      let byte = Number(value & 0x7fn);
+      value >>= 7n;
+      if (value > 0n) {
+        byte |= 0x80;
+      }
+      this.bytes.push(byte);
+    } while (value > 0n);
+  }
+
+  writeFloat(value) {
+    const buffer = Buffer.alloc(8);
+    buffer.writeDoubleLE(value);
+    this.writeBytes(buffer);
+  }
+
+  writeBytes(content, prefixLength = false) {
+    if (prefixLength) {
+      this.writeUint(content.length);
+    }
+    this.flush();
+    this.chunks.push(Buffer.from(content));
+  }
+
+  flush() {
+    if (this.bytes.length > 0) {
+      this.chunks.push(Buffer.from(this.bytes));
+      this.bytes = [];
+    }
+  }
+
+  getBytes() {
+    this.flush();
+    return Buffer.concat(this.chunks);
+  }
+}
@@ -0,0 +1,45 @@
+import { createHash } from 'node:crypto';
+import { readFile, rename, writeFile } from 'node:fs/promises';
+import { deleteFile, loadFile } from './utility-functions.js';
+
+// Code generated from structures acquired from a native module is saved alongside the module so
+// that later loads don't need to run the factory thunk. The key covers the content of the
+// library as well as everything else that affects the generated code.
+
+export function getSnapshotPath(libPath) {
+  return `${libPath}.snapshot.json`;
+}
+
+export async function getSnapshotKey(libPath, params) {
+  const hash = createHash('sha1');
+  hash.update(await readFile(libPath));
+  hash.update(JSON.stringify(params));
+  return hash.digest('hex');
+}
+
+export async function loadStructureSnapshot(libPath, key) {
+  try {
+    const snapshot = JSON.parse(await loadFile(getSnapshotPath(libPath), 'null'));
+    if (snapshot?.key === key) {
+      return snapshot.code;
+    }
+  } catch (err) {
+  }
+  return null;
+}
+
+export async function saveStructureSnapshot(libPath, key, code) {
+  const path = getSnapshotPath(libPath);
+  // write to temporary file first so other processes would never see a partial file
+  const tempPath = `${path}.${process.pid}.tmp`;
+  try {
+    await writeFile(tempPath, JSON.stringify({ key, code }));
+    await rename(tempPath, path);
+    return true;
+  } catch (err) {
+    // directory might not be writable (e.g. module is in an archive)
+    return false;
+  } finally {
+    await deleteFile(tempPath).catch(() => {});
+  }
+}
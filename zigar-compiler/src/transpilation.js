@@ -1,5 +1,6 @@
 import { readFile } from 'node:fs/promises';
 import { basename } from 'node:path';
+import { gzipSync } from 'node:zlib';
 import { defineEnvironment } from '../../zigar-runtime/src/environment.js';
 import * as mixins from '../../zigar-runtime/src/mixins.js';
 import { generateCode } from './code-generation.js';
@@ -10,12 +11,18 @@ export async function transpile(srcPath, options) {
   const {
     nodeCompat = false,
     embedWASM = true,
+    compressWASM = false,
+    reportEmbedding = false,
     topLevelAwait = true,
     omitExports = false,
     stripWASM = (options.optimize && options.optimize !== 'Debug'),
     keepNames = false,
+    lazyStructures = false,
+    binaryMetadata = false,
+    metrics = false,
     moduleResolver = (name) => name,
     wasmLoader,
+    workerPoolSize,
     ...compileOptions
   } = options;
   if (typeof(wasmLoader) !== 'function') {
@@ -34,9 +41,13 @@ export async function transpile(srcPath, options) {
     tableInitial,
     multithreaded,
   };
+  if (multithreaded && workerPoolSize !== undefined) {
+    moduleOptions.workerPoolSize = workerPoolSize;
+  }
   const Env = defineEnvironment();
   const env = new Env();
-  env.loadModule(content, moduleOptions);
+  // don't start any workers while we're just extracting structures
+  env.loadModule(content, { ...moduleOptions, workerPoolSize: 0 });
   await env.initPromise;
   env.acquireStructures();
   const definition = env.exportStructures();
@@ -46,6 +57,12 @@ export async function transpile(srcPath, options) {
       usage[name] = true;
     }
   }
+  if (binaryMetadata) {
+    usage.FeatureMetadataDecoding = true;
+  }
+  if (metrics) {
+    usage.FeatureCallMetrics = true;
+  }
   if (nodeCompat && usage.FeatureWorkerSupport) {
     usage.FeatureWorkerSupportCompat = true;
     usage.FeatureWorkerSupport = false;
@@ -62,14 +79,21 @@ export async function transpile(srcPath, options) {
     }
   }
   const runtimeURL = moduleResolver('zigar-runtime');
-  let binarySource;
+  let binarySource, embeddingReport, sizeReport;
   if (env.hasMethods()) {
     let dv = new DataView(content.buffer);
     if (stripWASM) {
       dv = stripUnused(dv, { keepNames });
     }
+    sizeReport = {
+      binarySize: content.byteLength,
+      strippedSize: dv.byteLength,
+    };
     if (embedWASM) {
-      binarySource = embed(srcPath, dv);
+      binarySource = embed(srcPath, dv, compressWASM);
+      if (reportEmbedding) {
+        embeddingReport = await measureEmbedding(srcPath, dv);
+      }
     } else {
       binarySource = await wasmLoader(srcPath, dv);
     }
@@ -82,12 +106,28 @@ export async function transpile(srcPath, options) {
     omitExports,
     moduleOptions,
     mixinPaths,
+    lazyStructures,
+    binaryMetadata,
   });
-  return { code, exports, structures, sourcePaths };
+  return { code, exports, structures, sourcePaths, embeddingReport, sizeReport };
 }
 
-function embed(path, dv) {
-  const base64 = Buffer.from(dv.buffer, dv.byteOffset, dv.byteLength).toString('base64');
+function embed(path, dv, compress) {
+  const bytes = Buffer.from(dv.buffer, dv.byteOffset, dv.byteLength);
+  if (compress) {
+    // decompress the data as it's being compiled
+    const base64 = gzipSync(bytes, { level: 9 }).toString('base64');
+    return `(async () => {
+  // ${basename(path)}
+  const base64 = ${JSON.stringify(base64)};
+  const bytes = (Uint8Array.fromBase64)
+  ? Uint8Array.fromBase64(base64)
+  : Uint8Array.from(atob(base64), c => c.charCodeAt(0));
+  const stream = new Blob([ bytes ]).stream().pipeThrough(new DecompressionStream('gzip'));
+  return new Response(stream, { headers: { 'Content-Type': 'application/wasm' } });
+})()`;
+  }
+  const base64 = bytes.toString('base64');
   return `(async () => {
   // ${basename(path)}
   const binaryString = atob(${JSON.stringify(base64)});
@@ -99,3 +139,23 @@ function embed(path, dv) {
   return bytes.buffer;
 })()`;
 }
+
+async function measureEmbedding(path, dv) {
+  const report = [];
+  for (const compress of [ false, true ]) {
+    const source = embed(path, dv, compress);
+    // run the loader the same way instantiateWebAssembly() does
+    const start = performance.now();
+    const res = await new Function(`return ${source}`)();
+    const suffix = (res[Symbol.toStringTag] === 'Response') ? 'Streaming' : '';
+    await WebAssembly['compile' + suffix](res);
+    const startupTime = performance.now() - start;
+    report.push({
+      mode: (compress) ? 'gzip' : 'base64',
+      binarySize: dv.byteLength,
+      size: source.length,
+      startupTime,
+    });
+  }
+  return report;
+}
@@ -0,0 +1,150 @@
+import { expect } from 'chai';
+import { mkdir, readFile, stat, writeFile } from 'fs/promises';
+import { tmpdir } from 'os';
+import { join } from 'path';
+
+import {
+  getArtifactCacheStats,
+  getZigEnv,
+  resetArtifactCacheStats,
+  restoreArtifact,
+  storeArtifact,
+} from '../src/artifact-cache.js';
+import { deleteDirectory } from '../src/utility-functions.js';
+
+describe('Artifact cache', function() {
+  this.timeout(0);
+  const rootDir = join(tmpdir(), 'zigar-artifact-cache-test');
+  const cacheDir = join(rootDir, 'cache');
+  beforeEach(async function() {
+    await deleteDirectory(rootDir);
+    resetArtifactCacheStats();
+  })
+  after(async function() {
+    await deleteDirectory(rootDir);
+  })
+  const createCheckout = async (name) => {
+    const moduleDir = join(rootDir, name, 'zig') + '/';
+    await mkdir(moduleDir, { recursive: true });
+    const srcPath = join(moduleDir, 'hello.zig');
+    const depPath = join(moduleDir, 'world.zig');
+    const buildFilePath = join(moduleDir, 'build.zig');
+    const extraFilePath = join(moduleDir, 'build.extra.zig');
+    const cHeaderPath = join(moduleDir, 'build.extra.h');
+    await writeFile(srcPath, 'const world = @import("./world.zig");');
+    await writeFile(depPath, 'pub const x = 1234;');
+    await writeFile(buildFilePath, '// build file');
+    await writeFile(extraFilePath, '// extra build file');
+    await writeFile(cHeaderPath, '// extra header');
+    const outputPath = join(rootDir, name, 'lib', 'hello.zigar', 'linux.x64.so');
+    const config = {
+      zigPath: 'zig',
+      moduleName: 'hello',
+      moduleDir,
+      buildFilePath,
+      extraFilePath,
+      cHeaderPath,
+      outputPath,
+      platform: 'linux',
+      arch: 'x64',
+      optimize: 'Debug',
+      zigArgs: [ 'build', '-Doptimize=Debug' ],
+    };
+    return { config, srcPath, depPath };
+  };
+  describe('getZigEnv', function() {
+    it('should obtain version of Zig compiler', async function() {
+      const { version, libDir } = await getZigEnv('zig');
+      expect(version).to.be.a('string');
+      expect(libDir).to.be.a('string');
+    })
+  })
+  describe('restoreArtifact', function() {
+    it('should return null when cache is empty', async function() {
+      const { config } = await createCheckout('a');
+      const result = await restoreArtifact(cacheDir, config);
+      expect(result).to.be.null;
+      expect(getArtifactCacheStats()).to.include({ hits: 0, misses: 1 });
+    })
+    it('should restore artifact built in a different checkout', async function() {
+      const a = await createCheckout('a');
+      await mkdir(join(a.config.outputPath, '..'), { recursive: true });
+      await writeFile(a.config.outputPath, 'binary');
+      const stored = await storeArtifact(cacheDir, a.config, [ a.srcPath, a.depPath ]);
+      expect(stored).to.be.true;
+      const b = await createCheckout('b');
+      const result = await restoreArtifact(cacheDir, b.config);
+      expect(result).to.not.be.null;
+      expect(result.sourcePaths).to.include(b.srcPath).and.to.include(b.depPath);
+      const content = await readFile(b.config.outputPath, 'utf-8');
+      expect(content).to.equal('binary');
+      expect(getArtifactCacheStats()).to.include({ hits: 1, misses: 0, stores: 1 });
+    })
+    it('should not restore artifact when a source file has changed', async function() {
+      const a = await createCheckout('a');
+      await mkdir(join(a.config.outputPath, '..'), { recursive: true });
+      await writeFile(a.config.outputPath, 'binary');
+      await storeArtifact(cacheDir, a.config, [ a.srcPath, a.depPath ]);
+      const b = await createCheckout('b');
+      await writeFile(b.depPath, 'pub const x = 4567;');
+      const result = await restoreArtifact(cacheDir, b.config);
+      expect(result).to.be.null;
+    })
+    it('should not restore artifact when build.extra.zig or build.extra.h has changed', async function() {
+      const a = await createCheckout('a');
+      await mkdir(join(a.config.outputPath, '..'), { recursive: true });
+      await writeFile(a.config.outputPath, 'binary');
+      await storeArtifact(cacheDir, a.config, [ a.srcPath, a.depPath ]);
+      const b = await createCheckout('b');
+      await writeFile(b.config.extraFilePath, '// changed');
+      const result1 = await restoreArtifact(cacheDir, b.config);
+      expect(result1).to.be.null;
+      const c = await createCheckout('c');
+      await writeFile(c.config.cHeaderPath, '// changed');
+      const result2 = await restoreArtifact(cacheDir, c.config);
+      expect(result2).to.be.null;
+    })
+    it('should not restore artifact when options are different', async function() {
+      const a = await createCheckout('a');
+      await mkdir(join(a.config.outputPath, '..'), { recursive: true });
+      await writeFile(a.config.outputPath, 'binary');
+      await storeArtifact(cacheDir, a.config, [ a.srcPath, a.depPath ]);
+      const b = await createCheckout('b');
+      b.config.optimize = 'ReleaseSmall';
+      const result = await restoreArtifact(cacheDir, b.config);
+      expect(result).to.be.null;
+    })
+    it('should not count artifact that cannot be copied as a hit', async function() {
+      const a = await createCheckout('a');
+      await mkdir(join(a.config.outputPath, '..'), { recursive: true });
+      await writeFile(a.config.outputPath, 'binary');
+      await storeArtifact(cacheDir, a.config, [ a.srcPath, a.depPath ]);
+      const b = await createCheckout('b');
+      // put a file where the output directory should be
+      await mkdir(join(b.config.outputPath, '../..'), { recursive: true });
+      await writeFile(join(b.config.outputPath, '..'), 'not a directory');
+      const result = await restoreArtifact(cacheDir, b.config);
+      expect(result).to.be.null;
+      expect(getArtifactCacheStats()).to.include({ hits: 0, misses: 1, errors: 1 });
+    })
+    it('should leave output file untouched when it matches the artifact', async function() {
+      const a = await createCheckout('a');
+      await mkdir(join(a.config.outputPath, '..'), { recursive: true });
+      await writeFile(a.config.outputPath, 'binary');
+      await storeArtifact(cacheDir, a.config, [ a.srcPath, a.depPath ]);
+      const before = await stat(a.config.outputPath);
+      const result = await restoreArtifact(cacheDir, a.config);
+      const after = await stat(a.config.outputPath);
+      expect(result).to.not.be.null;
+      expect(after.mtimeMs).to.equal(before.mtimeMs);
+    })
+  })
+  describe('storeArtifact', function() {
+    it('should return false when output file is missing', async function() {
+      const { config, srcPath } = await createCheckout('a');
+      const stored = await storeArtifact(cacheDir, config, [ srcPath ]);
+      expect(stored).to.be.false;
+      expect(getArtifactCacheStats()).to.include({ stores: 0, errors: 1 });
+    })
+  })
+})
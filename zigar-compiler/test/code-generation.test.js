@@ -275,5 +275,37 @@ describe('Code generation', function() {
       expect(code).to.contain('ADDON_PATH');
       expect(code).to.contain('/tmp/somewhere');
     })
+    it('should request lazy definition of structures when lazyStructures is true', function() {
+      const structure = {
+        constructor: null,
+        type: StructureType.Primitive,
+        name: "f32",
+        byteSize: 4,
+        isConst: false,
+        hasPointer: false,
+        instance: {
+          members: [
+            {
+              type: MemberType.Float,
+              bitOffset: 0,
+              bitSize: 32,
+              byteSize: 4,
+            }
+          ],
+          methods: [],
+          template: null,
+        },
+        static: {
+          members: [],
+          methods: [],
+          template: null,
+        },
+      };
+      const def = { structures: [ structure ], settings };
+      const { code: eager } = generateCode(def, { ...params });
+      const { code: lazy } = generateCode(def, { ...params, lazyStructures: true });
+      expect(eager).to.contain('recreateStructures(structures, settings);');
+      expect(lazy).to.contain('recreateStructures(structures, settings, true);');
+    })
   })
 })
@@ -10,6 +10,7 @@ use(chaiAsPromised);
 import {
   compile,
   createConfig,
+  formatProjectConfig,
   getModuleCachePath,
   runCompiler,
   test,
@@ -41,6 +42,35 @@ describe('Compilation', function() {
       expect(startCount).to.equal(2);
       expect(endCount).to.equal(2);
     })
+    it('should run builds in parallel up to the given limit', async function() {
+      let active = 0, peak = 0;
+      const onStart = () => peak = Math.max(peak, ++active);
+      const onEnd = () => active--;
+      const args = [ '-e', 'setTimeout(() => {}, 250)' ];
+      const options = { cwd: tmpdir(), onStart, onEnd, maxConcurrentBuilds: 2 };
+      const promises = [];
+      for (let i = 0; i < 5; i++) {
+        promises.push(runCompiler(process.execPath, args, options));
+      }
+      await Promise.all(promises);
+      expect(peak).to.equal(2);
+      expect(active).to.equal(0);
+    })
+    it('should run builds one at a time when limit is 1', async function() {
+      let active = 0, peak = 0;
+      const onStart = () => peak = Math.max(peak, ++active);
+      const onEnd = () => active--;
+      const args = [ '-e', 'setTimeout(() => {}, 100)' ];
+      const options = { cwd: tmpdir(), onStart, onEnd, maxConcurrentBuilds: 1 };
+      const promises = [];
+      for (let i = 0; i < 3; i++) {
+        promises.push(runCompiler(process.execPath, args, options));
+      }
+      promises.push(runCompiler(process.execPath, [ '-e', 'process.exit(1)' ], options).catch(() => {}));
+      promises.push(runCompiler(process.execPath, args, options));
+      await Promise.all(promises);
+      expect(peak).to.equal(1);
+    })
   })
   describe('getModuleCachePath', function () {
     it('should return cache path for source file', function() {
@@ -103,6 +133,23 @@ describe('Compilation', function() {
       expect(config.outputPath).to.equal(join(modPath, 'freebsd.arm64.so'));
     })
   })
+  describe('formatProjectConfig', function() {
+    it('should format list of used exports in Zig syntax', async function() {
+      const srcPath = '/project/src/hello.zig';
+      const options = { usedExports: [ 'world', 'hello' ] };
+      const modPath = join('lib', 'hello.zigar');
+      const config = await createConfig(srcPath, modPath, options);
+      const content = formatProjectConfig(config);
+      expect(content).to.contain('pub const used_exports: ?[]const []const u8 = &.{ "hello", "world" };');
+    })
+    it('should set used_exports to null when option is absent', async function() {
+      const srcPath = '/project/src/hello.zig';
+      const modPath = join('lib', 'hello.zigar');
+      const config = await createConfig(srcPath, modPath, {});
+      const content = formatProjectConfig(config);
+      expect(content).to.contain('pub const used_exports: ?[]const []const u8 = null;');
+    })
+  })
   describe('compile', function() {
     it('should compile zig source code for C addon', async function() {
       const srcPath = absolute('./zig-samples/basic/integers.zig');
@@ -136,6 +183,21 @@ describe('Compilation', function() {
       const { size } = await stat(outputPath);
       expect(size).to.be.at.least(1000);
     })
+    it('should restore library from artifact cache', async function() {
+      const srcPath = absolute('./zig-samples/basic/integers.zig');
+      const artifactCacheDir = join(tmpdir(), 'zigar-artifact-cache');
+      const options = { optimize: 'ReleaseSmall', arch: 'x64', platform: 'linux', artifactCacheDir };
+      const modPath = getModuleCachePath(srcPath, options);
+      const result1 = await compile(srcPath, modPath, options);
+      const { size } = await stat(result1.outputPath);
+      expect(size).to.be.at.least(1000);
+      const buildDir = join(tmpdir(), 'zigar-build-artifact-cache-test');
+      const result2 = await compile(srcPath, modPath, { ...options, buildDir });
+      expect(result2.cached).to.be.true;
+      expect(result2.sourcePaths).to.include(srcPath);
+      const info = await stat(result2.outputPath);
+      expect(info.size).to.equal(size);
+    })
     it('should compile code for Windows-ia32', async function() {
       const srcPath = absolute('./zig-samples/basic/integers.zig');
       const options = { optimize: 'ReleaseSmall', arch: 'ia32', platform: 'win32' };
@@ -0,0 +1,21 @@
+const std = @import("std");
+
+pub const Point = extern struct {
+    x: f64,
+    y: f64,
+    id: u32,
+    flag: bool,
+};
+
+pub fn createPoints(allocator: std.mem.Allocator, count: usize) ![]Point {
+    const points = try allocator.alloc(Point, count);
+    for (points, 0..) |*point, index| {
+        point.* = .{
+            .x = @floatFromInt(index),
+            .y = 0,
+            .id = @intCast(index),
+            .flag = index % 2 == 0,
+        };
+    }
+    return points;
+}
@@ -0,0 +1,47 @@
+const std = @import("std");
+
+pub fn empty() void {}
+
+pub fn add(a: i32, b: i32) i32 {
+    return a +% b;
+}
+
+pub fn getLength(text: []const u8) usize {
+    return text.len;
+}
+
+pub fn getGreeting(allocator: std.mem.Allocator, name: []const u8) ![]const u8 {
+    return try std.fmt.allocPrint(allocator, "Hello, {s}!", .{name});
+}
+
+pub fn sum(values: []const f64) f64 {
+    var total: f64 = 0;
+    for (values) |value| total += value;
+    return total;
+}
+
+pub fn sumNested(lists: []const []const f64) f64 {
+    var total: f64 = 0;
+    for (lists) |list| total += sum(list);
+    return total;
+}
+
+pub fn duplicate(allocator: std.mem.Allocator, values: []const f64) ![]f64 {
+    return try allocator.dupe(f64, values);
+}
+
+pub fn callRepeatedly(cb: *const fn (i32) i32, count: i32) i32 {
+    var total: i32 = 0;
+    for (0..@intCast(count)) |i| total +%= cb(@intCast(i));
+    return total;
+}
+
+const module = @This();
+pub const @"meta(zigar)" = struct {
+    pub fn isDeclString(comptime T: type, comptime decl: std.meta.DeclEnum(T)) bool {
+        return switch (T) {
+            module => decl == .getGreeting,
+            else => false,
+        };
+    }
+};
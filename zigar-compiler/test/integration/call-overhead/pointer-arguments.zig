@@ -0,0 +1,7 @@
+pub fn sum(slices: []const []const u32) u32 {
+    var total: u32 = 0;
+    for (slices) |slice| {
+        for (slice) |value| total +%= value;
+    }
+    return total;
+}
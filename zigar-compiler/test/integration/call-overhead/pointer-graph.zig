@@ -0,0 +1,13 @@
+pub const Node = struct {
+    value: i32,
+};
+
+pub const Graph = struct {
+    nodes: []const *const Node,
+};
+
+pub fn sum(graph: *const Graph) i32 {
+    var total: i32 = 0;
+    for (graph.nodes) |node| total +%= node.value;
+    return total;
+}
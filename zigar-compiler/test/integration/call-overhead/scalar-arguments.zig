@@ -0,0 +1,13 @@
+pub fn add(a: i32, b: i32) i32 {
+    return a +% b;
+}
+
+pub fn scale(value: f64, factor: f64) f64 {
+    return value * factor;
+}
+
+pub fn addAll(list: []const i32) i32 {
+    var total: i32 = 0;
+    for (list) |value| total +%= value;
+    return total;
+}
@@ -0,0 +1,32 @@
+const std = @import("std");
+
+pub const Wide = struct {
+    a: f64,
+    b: i32,
+    c: u64,
+    d: bool,
+};
+
+pub const Deep = struct {
+    items: [4]Wide,
+    flags: @Vector(4, bool),
+    id: u64,
+};
+
+pub fn createDeepStructs(allocator: std.mem.Allocator, count: usize) ![]Deep {
+    const list = try allocator.alloc(Deep, count);
+    for (list, 0..) |*item, index| {
+        const wide: Wide = .{
+            .a = @floatFromInt(index),
+            .b = -@as(i32, @intCast(index)),
+            .c = index * 3,
+            .d = index % 2 == 0,
+        };
+        item.* = .{
+            .items = .{ wide, wide, wide, wide },
+            .flags = .{ true, false, index % 2 == 0, true },
+            .id = index,
+        };
+    }
+    return list;
+}
@@ -0,0 +1,40 @@
+const std = @import("std");
+
+fn Record(comptime index: usize) type {
+    return struct {
+        a: i32 = index,
+        b: i32 = 0,
+    };
+}
+
+fn Collection(comptime count: usize) type {
+    @setEvalBranchQuota(count * 100);
+    comptime var fields: [count]std.builtin.Type.StructField = undefined;
+    inline for (&fields, 0..) |*field, index| {
+        const T = Record(index);
+        field.* = .{
+            .name = std.fmt.comptimePrint("r{d}", .{index}),
+            .type = T,
+            .default_value_ptr = null,
+            .is_comptime = false,
+            .alignment = @alignOf(T),
+        };
+    }
+    return @Type(.{
+        .@"struct" = .{
+            .layout = .auto,
+            .fields = &fields,
+            .decls = &.{},
+            .is_tuple = false,
+        },
+    });
+}
+
+// 1000 distinct struct types, of which only two get used
+pub const Records = Collection(1000);
+pub const First = Record(0);
+pub const Second = Record(1);
+
+pub fn sum(first: First, second: Second) i32 {
+    return first.a + first.b + second.a + second.b;
+}
@@ -0,0 +1,262 @@
+import { expect } from 'chai';
+import { mkdirSync, writeFileSync } from 'fs';
+import 'mocha-skip-if';
+import { join } from 'path';
+
+export function addTests(importModule, options) {
+  const { optimize, target, compilerVersion } = options;
+  const importTest = async (name, options) => {
+    const url = new URL(`./${name}.zig`, import.meta.url).href;
+    return importModule(url, options);
+  };
+  // results are saved as JSON when ZIGAR_BENCHMARK_REPORT points to a directory, so that numbers
+  // from different releases can be compared
+  const runtime = (typeof(Bun) === 'object') ? 'bun' : 'node';
+  const report = {
+    runtime,
+    runtimeVersion: (runtime === 'bun') ? Bun.version : process.versions.node,
+    compilerVersion,
+    target,
+    optimize,
+    date: new Date().toISOString(),
+    results: {},
+  };
+  const record = (name, elapsed, count, unit = 'call') => {
+    const ns = elapsed * 1e6 / count;
+    report.results[name] = { ns, unit };
+    return `${name}: ${(ns / 1000).toFixed(3)}µs per ${unit}`;
+  };
+  const measure = (name, iterations, f) => {
+    // warm up
+    for (let i = 0; i < Math.min(iterations, 100); i++) {
+      f(i);
+    }
+    const start = performance.now();
+    for (let i = 0; i < iterations; i++) {
+      f(i);
+    }
+    return record(name, performance.now() - start, iterations);
+  };
+  describe('Call overhead', function() {
+    this.timeout(0);
+    after(function() {
+      const dir = process.env.ZIGAR_BENCHMARK_REPORT;
+      if (dir && Object.keys(report.results).length > 0) {
+        mkdirSync(dir, { recursive: true });
+        const path = join(dir, `call-overhead-${runtime}-${target}-${optimize}.json`);
+        writeFileSync(path, JSON.stringify(report, null, 2));
+      }
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure cost of calls with scalar arguments', async function() {
+      const { add, scale, addAll } = await importTest('scalar-arguments');
+      const iterations = 100000;
+      expect(add(1, 2)).to.equal(3);
+      expect(scale(1.5, 2)).to.equal(3);
+      const list = [ 1 ];
+      const results = [
+        measure('add(i32, i32)', iterations, i => add(i, 1)),
+        measure('scale(f64, f64)', iterations, i => scale(i, 0.5)),
+        // slice argument takes the regular path, for comparison
+        measure('addAll([]const i32)', iterations, i => addAll(list)),
+      ];
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure cost of calls with pointer arguments', async function() {
+      const { sum } = await importTest('pointer-arguments');
+      const iterations = 10000;
+      const results = [];
+      for (const count of [ 1, 10, 100 ]) {
+        // every slice is a separate JavaScript buffer needing its own shadow
+        const slices = [];
+        for (let i = 0; i < count; i++) {
+          slices.push(new Uint32Array([ i, i, i, i ]));
+        }
+        expect(sum(slices)).to.equal(count * (count - 1) * 2);
+        results.push(measure(`sum(${count} pointer(s))`, iterations, () => sum(slices)));
+      }
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure cost of calls with deep pointer graph', async function() {
+      const { Graph, sum } = await importTest('pointer-graph');
+      const count = 10000;
+      const nodes = [];
+      for (let i = 0; i < count; i++) {
+        nodes.push({ value: 1 });
+      }
+      const graph = new Graph({ nodes });
+      expect(sum(graph)).to.equal(count);
+      const unchanged = measure(`sum(${count} pointers, unchanged)`, 100, () => sum(graph));
+      // changing a pointer means the graph has to be walked again
+      const before = performance.now();
+      graph.nodes[0] = { value: 2 };
+      expect(sum(graph)).to.equal(count + 1);
+      const changed = record(`sum(${count} pointers, after change)`, performance.now() - before, 1);
+      console.log(`\n      ${unchanged}\n      ${changed}`);
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure cost of marshaling different argument types', async function() {
+      const {
+        empty, add, getLength, getGreeting, sum, sumNested, duplicate, callRepeatedly,
+      } = await importTest('marshaling');
+      const iterations = 100000;
+      const text = 'Hello world'.repeat(10);
+      const array = new Array(1000).fill(0.5);
+      const typedArray = new Float64Array(array);
+      const nested = [ typedArray, typedArray, typedArray, typedArray ];
+      expect(getLength(text)).to.equal(text.length);
+      expect(getGreeting('Bob')).to.equal('Hello, Bob!');
+      expect(sum(array)).to.equal(500);
+      expect(sum(typedArray)).to.equal(500);
+      expect(sumNested(nested)).to.equal(2000);
+      expect([ ...duplicate(typedArray) ]).to.eql(array);
+      expect(callRepeatedly(i => i, 4)).to.equal(6);
+      const results = [
+        measure('empty()', iterations, () => empty()),
+        measure('add(i32, i32)', iterations, i => add(i, 1)),
+        measure('getLength([]const u8)', iterations, () => getLength(text)),
+        measure('getGreeting(Allocator, []const u8) []const u8', iterations / 10, () => getGreeting('Bob')),
+        // a regular array has to be copied into a new buffer, a typed array can be used as is
+        measure('sum([]const f64, copied)', iterations / 10, () => sum(array)),
+        measure('sum([]const f64, zero-copy)', iterations / 10, () => sum(typedArray)),
+        measure('sumNested([]const []const f64)', iterations / 10, () => sumNested(nested)),
+        measure('duplicate(Allocator, []const f64) []f64', iterations / 10, () => duplicate(typedArray)),
+      ];
+      const callbackCount = 10000;
+      const start = performance.now();
+      callRepeatedly(i => i, callbackCount);
+      results.push(record('callback (main thread)', performance.now() - start, callbackCount, 'callback'));
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure cost of moving structs in and out of typed arrays', async function() {
+      const { createPoints } = await importTest('columns');
+      const count = 100000;
+      const points = createPoints(count);
+      const columns = points.toColumns();
+      expect(columns.id[count - 1]).to.equal(count - 1);
+      const results = [
+        measure(`toColumns() (${count} structs)`, 10, () => points.toColumns()),
+        measure(`fromColumns() (${count} structs)`, 10, () => points.fromColumns(columns)),
+        // for comparison, the same data obtained through element objects
+        measure(`valueOf() of each element (${count} structs)`, 10, () => {
+          for (const point of points) {
+            point.valueOf();
+          }
+        }),
+      ];
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure cost of converting structs to plain objects', async function() {
+      const { createDeepStructs } = await importTest('serialization');
+      const count = 2000;
+      const list = createDeepStructs(count);
+      expect(list.valueOf()[3].flags).to.eql([ true, false, false, true ]);
+      expect(list.toJSON()[3].id).to.equal(3);
+      const results = [
+        measure(`valueOf() (${count} nested structs)`, 10, () => list.valueOf()),
+        measure(`toJSON() (${count} nested structs)`, 10, () => list.toJSON()),
+      ];
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure overhead of gathering call metrics', async function() {
+      const { add, getLength, __zigar } = await importTest('marshaling', { metrics: true });
+      const iterations = 100000;
+      const text = 'Hello world';
+      const results = [
+        measure('add(i32, i32), metrics off', iterations, i => add(i, 1)),
+        measure('getLength([]const u8), metrics off', iterations, () => getLength(text)),
+      ];
+      __zigar.startMetrics();
+      try {
+        results.push(
+          measure('add(i32, i32), metrics on', iterations, i => add(i, 1)),
+          measure('getLength([]const u8), metrics on', iterations, () => getLength(text)),
+        );
+        const { functions } = __zigar.getMetrics();
+        expect(functions.find(f => f.name === 'add')?.count).to.be.at.least(iterations);
+      } finally {
+        __zigar.stopMetrics();
+      }
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+    // binary metadata and lazy definition are only available in transpiled code
+    skip.if(optimize === 'Debug' || target !== 'wasm32').
+    it('should measure startup time of module with many types', async function() {
+      const modes = {
+        'object literals': {},
+        'binary metadata': { binaryMetadata: true },
+        'defined on first use': { lazyStructures: true },
+      };
+      const results = [];
+      for (const [ mode, options ] of Object.entries(modes)) {
+        // the first import compiles the module, the second only bundles and loads it
+        await importTest('startup', options);
+        const start = performance.now();
+        const { First, Second, sum } = await importTest('startup', { ...options, run: 2 });
+        expect(sum(new First({ b: 1 }), new Second({ b: 2 }))).to.equal(4);
+        results.push(record(`startup (1000 types, ${mode})`, performance.now() - start, 1, 'load'));
+      }
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure cost of calls crossing threads', async function() {
+      const {
+        startup, shutdown, callFromThread, generate, returnInt,
+      } = await importTest('threading', { multithreaded: true });
+      startup();
+      try {
+        const results = [];
+        const callbackCount = 10000;
+        let start = performance.now();
+        const total = await callFromThread(i => 1, callbackCount);
+        results.push(record('callback (worker thread)', performance.now() - start, callbackCount, 'callback'));
+        expect(total).to.equal(callbackCount);
+        const promiseCount = 1000;
+        start = performance.now();
+        for (let i = 0; i < promiseCount; i++) {
+          await returnInt(i);
+        }
+        results.push(record('promise (work queue)', performance.now() - start, promiseCount, 'promise'));
+        const itemCount = 10000;
+        let received = 0;
+        start = performance.now();
+        for await (const value of generate(itemCount)) {
+          received++;
+        }
+        results.push(record('generator (worker thread)', performance.now() - start, itemCount, 'item'));
+        expect(received).to.equal(itemCount);
+        console.log(`\n      ${results.join('\n      ')}`);
+      } finally {
+        await shutdown();
+      }
+    })
+    skip.if(optimize === 'Debug').
+    it('should measure throughput of work queue', async function() {
+      const { startup, run, shutdown } = await importTest('work-queue', { multithreaded: true });
+      const cases = [
+        { name: 'tiny jobs', jobs: 200000, iterations: 10 },
+        { name: 'large jobs', jobs: 256, iterations: 2000000 },
+      ];
+      const results = [];
+      for (const { name, jobs, iterations } of cases) {
+        for (const threads of [ 1, 2, 4, 8, 16 ]) {
+          for (const scheduling of [ 'shared', 'work_stealing' ]) {
+            await startup(scheduling, threads);
+            try {
+              const elapsed = await run(jobs, iterations);
+              results.push(record(`${name} (${threads} thread(s), ${scheduling})`, elapsed, jobs, 'job'));
+            } finally {
+              await shutdown();
+            }
+          }
+        }
+      }
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
+  })
+}
@@ -0,0 +1,47 @@
+const std = @import("std");
+
+const zigar = @import("zigar");
+
+var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+var work_queue: zigar.thread.WorkQueue(worker_ns) = .{};
+var remaining: std.atomic.Value(usize) = .init(0);
+var timer: std.time.Timer = undefined;
+var run_promise: zigar.function.Promise(f64) = undefined;
+
+pub const Scheduling = enum { shared, work_stealing };
+
+pub fn startup(scheduling: Scheduling, n_jobs: usize, promise: zigar.function.Promise(void)) !void {
+    try work_queue.init(.{
+        .allocator = gpa.allocator(),
+        .n_jobs = n_jobs,
+        .scheduling = switch (scheduling) {
+            .shared => .shared,
+            .work_stealing => .work_stealing,
+        },
+    });
+    work_queue.waitAsync(promise);
+}
+
+pub fn shutdown(promise: zigar.function.Promise(void)) void {
+    work_queue.deinitAsync(promise);
+}
+
+// resolves the promise with the time in milliseconds it took for all jobs to finish
+pub fn run(jobs: usize, iterations: usize, promise: zigar.function.Promise(f64)) !void {
+    remaining.store(jobs, .release);
+    run_promise = promise;
+    timer = try std.time.Timer.start();
+    for (0..jobs) |_| try work_queue.push(worker_ns.spin, .{iterations}, null);
+}
+
+const worker_ns = struct {
+    pub fn spin(iterations: usize) void {
+        var x: u64 = iterations;
+        for (0..iterations) |i| x = x *% 6364136223846793005 +% i;
+        std.mem.doNotOptimizeAway(x);
+        if (remaining.fetchSub(1, .acq_rel) == 1) {
+            const ns: f64 = @floatFromInt(timer.read());
+            run_promise.resolve(ns / std.time.ns_per_ms);
+        }
+    }
+};
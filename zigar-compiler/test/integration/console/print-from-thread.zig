@@ -0,0 +1,41 @@
+const std = @import("std");
+const zigar = @import("zigar");
+const c = @import("c");
+
+var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+
+pub fn print(promise: zigar.function.Promise(void)) !void {
+    const ns = struct {
+        fn run(p: zigar.function.Promise(void)) void {
+            const fd = std.posix.STDOUT_FILENO;
+            // these end up in the thread's output buffer
+            _ = std.posix.write(fd, "Line 1\n") catch {};
+            const iovs = [_]std.posix.iovec_const{
+                .{ .base = "Line ", .len = 5 },
+                .{ .base = "2\n", .len = 2 },
+            };
+            _ = std.posix.writev(fd, &iovs) catch {};
+            // buffered output is sent out before a positional write is attempted
+            _ = std.posix.pwrite(fd, "Line 3\n", 0) catch {
+                _ = std.posix.write(fd, "Line 3\n") catch {};
+            };
+            _ = std.posix.write(fd, "Line 4\n") catch {};
+            // output from stdio goes into the same buffer before everything gets flushed
+            c.test_printf_then_fflush("Line 5\n");
+            p.resolve({});
+        }
+    };
+    const thread = try std.Thread.spawn(.{
+        .allocator = gpa.allocator(),
+        .stack_size = 1024 * 1024,
+    }, ns.run, .{promise});
+    thread.detach();
+}
+
+pub fn startup() !void {
+    try zigar.thread.use();
+}
+
+pub fn shutdown() void {
+    zigar.thread.end();
+}
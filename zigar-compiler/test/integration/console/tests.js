@@ -1,4 +1,5 @@
 import { expect } from 'chai';
+import 'mocha-skip-if';
 import { platform } from 'os';
 import { capture } from '../test-utils.js';
 
@@ -57,5 +58,16 @@ export function addTests(importModule, options) {
       : 'Hello: No such file or directory';
       expect(await capture(() => test_perror())).eql([ errorMsg ]);
     })
+    skip.if(target === 'wasm32').or(platform() === 'win32').
+    it('should keep output from thread in order', async function() {
+      const { startup, shutdown, print } = await importTest('print-from-thread', { multithreaded: true, useLibc: true });
+      startup();
+      try {
+        const lines = await capture(() => print());
+        expect(lines).to.eql([ 'Line 1', 'Line 2', 'Line 3', 'Line 4', 'Line 5' ]);
+      } finally {
+        shutdown();
+      }
+    })
   })
 }
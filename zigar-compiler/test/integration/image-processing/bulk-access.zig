@@ -0,0 +1,98 @@
+const std = @import("std");
+
+const zigar = @import("zigar");
+
+const Pixel = @Vector(4, f32);
+const lane_count = 8;
+const radius = 3;
+
+pub fn blurPerPixel(image_in: zigar.image.Any(.ro), image_out: zigar.image.Any(.rw)) void {
+    inline for (zigar.image.formats) |tag| {
+        if (image_in == tag and image_out == tag) {
+            const in = image_in.getField(tag);
+            const out = image_out.getField(tag);
+            const width = in.getWidth();
+            const scale: Pixel = @splat(1.0 / @as(f32, @floatFromInt(radius * 2 + 1)));
+            for (0..in.getHeight()) |y| {
+                for (0..width) |x| {
+                    var sum: Pixel = @splat(0);
+                    for (0..radius * 2 + 1) |i| {
+                        const sx = @min(width - 1, (x + i) -| radius);
+                        sum += in.getPixel(Pixel, sx, y);
+                    }
+                    out.setPixel(Pixel, x, y, sum * scale);
+                }
+            }
+        }
+    }
+}
+
+pub fn blurByRow(image_in: zigar.image.Any(.ro), image_out: zigar.image.Any(.rw)) !void {
+    inline for (zigar.image.formats) |tag| {
+        if (image_in == tag and image_out == tag) {
+            const in = image_in.getField(tag);
+            const out = image_out.getField(tag);
+            const width = in.getWidth();
+            const allocator = std.heap.page_allocator;
+            const row_in = try allocator.alloc(Pixel, width);
+            defer allocator.free(row_in);
+            const row_out = try allocator.alloc(Pixel, width);
+            defer allocator.free(row_out);
+            const scale: Pixel = @splat(1.0 / @as(f32, @floatFromInt(radius * 2 + 1)));
+            for (0..in.getHeight()) |y| {
+                in.getRow(Pixel, 0, y, row_in);
+                for (0..width) |x| {
+                    var sum: Pixel = @splat(0);
+                    for (0..radius * 2 + 1) |i| {
+                        sum += row_in[@min(width - 1, (x + i) -| radius)];
+                    }
+                    row_out[x] = sum * scale;
+                }
+                out.setRow(Pixel, 0, y, row_out);
+            }
+        }
+    }
+}
+
+pub fn resizePerPixel(image_in: zigar.image.Any(.ro), image_out: zigar.image.Any(.rw)) void {
+    inline for (zigar.image.formats) |tag| {
+        if (image_in == tag and image_out == tag) {
+            const in = image_in.getField(tag);
+            const out = image_out.getField(tag);
+            const x_adv = in.getWidthAsFloat() / out.getWidthAsFloat();
+            const y_adv = in.getHeightAsFloat() / out.getHeightAsFloat();
+            for (0..out.getHeight()) |y| {
+                for (0..out.getWidth()) |x| {
+                    const coord: @Vector(2, f32) = .{
+                        (@as(f32, @floatFromInt(x)) + 0.5) * x_adv,
+                        (@as(f32, @floatFromInt(y)) + 0.5) * y_adv,
+                    };
+                    out.setPixel(Pixel, x, y, in.sampleLinear(Pixel, coord));
+                }
+            }
+        }
+    }
+}
+
+pub fn resizeByLanes(image_in: zigar.image.Any(.ro), image_out: zigar.image.Any(.rw)) void {
+    const V = @Vector(lane_count, f32);
+    inline for (zigar.image.formats) |tag| {
+        if (image_in == tag and image_out == tag) {
+            const in = image_in.getField(tag);
+            const out = image_out.getField(tag);
+            const x_adv: V = @splat(in.getWidthAsFloat() / out.getWidthAsFloat());
+            const y_adv: V = @splat(in.getHeightAsFloat() / out.getHeightAsFloat());
+            const half: V = @splat(0.5);
+            const offsets = std.simd.iota(f32, lane_count);
+            for (0..out.getHeight()) |y| {
+                const ys = (@as(V, @splat(@floatFromInt(y))) + half) * y_adv;
+                var x: usize = 0;
+                while (x < out.getWidth()) : (x += lane_count) {
+                    const xs = (@as(V, @splat(@floatFromInt(x))) + offsets + half) * x_adv;
+                    const lanes = in.sampleLinearN(Pixel, lane_count, .{ xs, ys });
+                    out.setPixels(Pixel, lane_count, x, y, lanes);
+                }
+            }
+        }
+    }
+}
@@ -1,4 +1,5 @@
 import { expect } from 'chai';
+import 'mocha-skip-if';
 import { mkdirSync } from 'fs';
 import { join } from 'path';
 import Sharp from 'sharp';
@@ -31,6 +32,36 @@ export function addTests(importModule, options) {
       const refImage = await loadImage(absolute('images/resized.png'));
       expect(compareImages(outputImage, refImage)).to.be.true;
     })
+    skip.if(optimize === 'Debug').
+    it('should measure speed-up of bulk pixel access', async function() {
+      const {
+        blurPerPixel, blurByRow, resizePerPixel, resizeByLanes,
+      } = await importTest('bulk-access');
+      const inputImage = await loadImage(absolute('images/malgorzata-socha.png'));
+      const iterations = 10;
+      const measure = (f, outputImage) => {
+        f(inputImage, outputImage);
+        const start = performance.now();
+        for (let i = 0; i < iterations; i++) {
+          f(inputImage, outputImage);
+        }
+        return (performance.now() - start) / iterations;
+      };
+      const results = [];
+      for (const [ name, perPixel, bulk, width, height ] of [
+        [ 'blur', blurPerPixel, blurByRow, inputImage.width, inputImage.height ],
+        [ 'resize', resizePerPixel, resizeByLanes, 384, 288 ],
+      ]) {
+        const outputImage1 = createImage(width, height);
+        const outputImage2 = createImage(width, height);
+        const time1 = measure(perPixel, outputImage1);
+        const time2 = measure(bulk, outputImage2);
+        // summation order can differ slightly
+        expect(compareImages(outputImage1, outputImage2, 1)).to.be.true;
+        results.push(`${name}: ${time1.toFixed(2)}ms per pixel, ${time2.toFixed(2)}ms bulk (${(time1 / time2).toFixed(1)}x)`);
+      }
+      console.log(`\n      ${results.join('\n      ')}`);
+    })
     it('should greyscale image', async function() {
       const { greyscale } = await importTest('greyscale');
       const path = absolute('images/malgorzata-socha.png');
@@ -159,11 +190,11 @@ async function loadImage(path) {
   return { data, width: info.width, height: info.height };
 }
 
-function compareImages(image1, image2) {
+function compareImages(image1, image2, tolerance = 0) {
   const data1 = image1.data;
   const data2 = image2.data;
   for (let i = 0; i < data1.length; i++) {
-    if (data1[i] !== data2[i]) return false;
+    if (Math.abs(data1[i] - data2[i]) > tolerance) return false;
   }
   return true;
 }
@@ -3,6 +3,7 @@ import { execSync } from 'child_process';
 import * as BenchmarksGame from './benchmarks-game/tests.js';
 import * as BugFixes from './bug-fixes/tests.js';
 import * as BuiltinFunctions from './builtin-functions/tests.js';
+import * as CallOverhead from './call-overhead/tests.js';
 import * as Console from './console/tests.js';
 import * as ErrorHandling from './error-handling/tests.js';
 import * as FunctionCalling from './function-calling/tests.js';
@@ -25,6 +26,7 @@ export function addTests(importModule, options) {
   BenchmarksGame.addTests(importModule, options);
   Console.addTests(importModule, options);
   BuiltinFunctions.addTests(importModule, options);
+  CallOverhead.addTests(importModule, options);
   ErrorHandling.addTests(importModule, options);
   FunctionCalling.addTests(importModule, options);
   FunctionPointer.addTests(importModule, options);
@@ -0,0 +1,113 @@
+import { expect } from 'chai';
+
+import { MemberType, StructureType } from '../../zigar-runtime/src/constants.js';
+import { defineEnvironment } from '../../zigar-runtime/src/environment.js';
+import '../../zigar-runtime/src/mixins.js';
+import { MEMORY, SLOTS } from '../../zigar-runtime/src/symbols.js';
+import { generateCode } from '../src/code-generation.js';
+import { encodeStructures } from '../src/metadata-encoding.js';
+
+const Env = defineEnvironment();
+
+describe('Metadata encoding', function() {
+  const settings = {
+    littleEndian: true,
+    runtimeSafety: true,
+    libc: false,
+  };
+  const createStructure = (index) => {
+    const structure = {
+      constructor: function() {},
+      type: StructureType.Struct,
+      name: `Struct${index}`,
+      flags: 0,
+      signature: 0xdead_beef_0000_0000n + BigInt(index),
+      byteSize: 8,
+      align: 4,
+      instance: {
+        members: [
+          {
+            name: 'number',
+            type: MemberType.Int,
+            flags: 0,
+            bitOffset: 0,
+            bitSize: 32,
+            byteSize: 4,
+            structure: null,
+          },
+          {
+            name: 'float',
+            type: MemberType.Float,
+            flags: 0,
+            bitOffset: 32,
+            bitSize: 32,
+            byteSize: 4,
+            structure: null,
+          },
+        ],
+        template: null,
+      },
+      static: {
+        members: [],
+        template: null,
+      },
+    };
+    return structure;
+  };
+  describe('encodeStructures', function() {
+    it('should produce data that can be decoded by the runtime', function() {
+      const structure = createStructure(0);
+      structure.instance.members[0].structure = structure;
+      const object = Object.create(structure.constructor.prototype);
+      object[MEMORY] = new DataView(new Uint8Array([ 1, 2, 3, 4, 5, 6, 7, 8 ]).buffer, 4, 4);
+      object[MEMORY].handle = 0x1234;
+      structure.static.template = { [SLOTS]: { 0: object } };
+      const bytes = encodeStructures({ structures: [ structure ], settings });
+      const env = new Env();
+      const result = env.decodeStructures(bytes.toString('base64'));
+      expect(result.structures).to.have.lengthOf(1);
+      expect(result.root).to.equal(result.structures[0]);
+      expect(result.settings).to.eql(settings);
+      const [ decoded ] = result.structures;
+      expect(decoded.constructor).to.be.null;
+      expect(decoded.name).to.equal('Struct0');
+      expect(decoded.signature).to.equal(0xdead_beef_0000_0000n);
+      expect(decoded.instance.members[0].structure).to.equal(decoded);
+      expect(decoded.instance.members[1]).to.include({ name: 'float', bitOffset: 32 });
+      const placeholder = decoded.static.template.slots[0];
+      expect(placeholder.structure).to.equal(decoded);
+      expect(placeholder.handle).to.equal(0x1234);
+      expect(placeholder.memory).to.include({ offset: 4, length: 4 });
+      expect([ ...placeholder.memory.array ]).to.eql([ 1, 2, 3, 4, 5, 6, 7, 8 ]);
+    })
+    it('should throw when version is not supported', function() {
+      const bytes = encodeStructures({ structures: [ createStructure(0) ], settings });
+      bytes[3] = 0xff;
+      const env = new Env();
+      expect(() => env.decodeStructures(bytes.toString('base64'))).to.throw();
+    })
+    it('should encode negative bigints', function() {
+      const values = {
+        min: -0x8000_0000_0000_0000n,
+        max: 0x7fff_ffff_ffff_ffffn,
+        negative: -1n,
+        zero: 0n,
+      };
+      const bytes = encodeStructures({ structures: [ createStructure(0) ], settings: values });
+      const env = new Env();
+      const result = env.decodeStructures(bytes.toString('base64'));
+      expect(result.settings).to.eql(values);
+    })
+    it('should yield smaller code than object literals', function() {
+      const structures = [];
+      for (let i = 0; i < 1000; i++) {
+        structures.push(createStructure(i));
+      }
+      const def = { structures, settings };
+      const params = { runtimeURL: 'zigar-runtime', omitExports: true };
+      const { code: literal } = generateCode(def, { ...params, binaryMetadata: false });
+      const { code: binary } = generateCode(def, { ...params, binaryMetadata: true });
+      expect(binary.length).to.be.below(literal.length);
+    })
+  })
+})
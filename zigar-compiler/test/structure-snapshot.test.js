@@ -0,0 +1,69 @@
+import { expect } from 'chai';
+import { mkdir, writeFile } from 'fs/promises';
+import { tmpdir } from 'os';
+import { join } from 'path';
+
+import {
+  getSnapshotKey,
+  getSnapshotPath,
+  loadStructureSnapshot,
+  saveStructureSnapshot,
+} from '../src/structure-snapshot.js';
+import { deleteDirectory } from '../src/utility-functions.js';
+
+describe('Structure snapshot', function() {
+  const rootDir = join(tmpdir(), 'zigar-structure-snapshot-test');
+  const libPath = join(rootDir, 'linux.x64.so');
+  const params = { outputPath: libPath, runtimeURL: 'file:///runtime.js', envVariables: {} };
+  beforeEach(async function() {
+    await deleteDirectory(rootDir);
+    await mkdir(rootDir, { recursive: true });
+    await writeFile(libPath, 'binary');
+  })
+  after(async function() {
+    await deleteDirectory(rootDir);
+  })
+  describe('getSnapshotPath', function() {
+    it('should place snapshot next to library', function() {
+      const path = getSnapshotPath(libPath);
+      expect(path).to.equal(`${libPath}.snapshot.json`);
+    })
+  })
+  describe('getSnapshotKey', function() {
+    it('should return different keys when parameters differ', async function() {
+      const key1 = await getSnapshotKey(libPath, params);
+      const key2 = await getSnapshotKey(libPath, { ...params, runtimeURL: 'file:///other.js' });
+      expect(key1).to.be.a('string');
+      expect(key2).to.not.equal(key1);
+    })
+  })
+  describe('loadStructureSnapshot', function() {
+    it('should return null when there is no snapshot', async function() {
+      const key = await getSnapshotKey(libPath, params);
+      const code = await loadStructureSnapshot(libPath, key);
+      expect(code).to.be.null;
+    })
+    it('should return code saved earlier', async function() {
+      const key = await getSnapshotKey(libPath, params);
+      const saved = await saveStructureSnapshot(libPath, key, 'export default 1234;');
+      expect(saved).to.be.true;
+      const code = await loadStructureSnapshot(libPath, key);
+      expect(code).to.equal('export default 1234;');
+    })
+    it('should return null when library has changed', async function() {
+      const key1 = await getSnapshotKey(libPath, params);
+      await saveStructureSnapshot(libPath, key1, 'export default 1234;');
+      await writeFile(libPath, 'different binary');
+      const key2 = await getSnapshotKey(libPath, params);
+      const code = await loadStructureSnapshot(libPath, key2);
+      expect(code).to.be.null;
+    })
+  })
+  describe('saveStructureSnapshot', function() {
+    it('should return false when directory does not exist', async function() {
+      const path = join(rootDir, 'missing', 'linux.x64.so');
+      const saved = await saveStructureSnapshot(path, 'abc', 'export default 1234;');
+      expect(saved).to.be.false;
+    })
+  })
+})
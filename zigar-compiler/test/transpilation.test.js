@@ -66,6 +66,26 @@ describe('Transpilation', function() {
       const { code: after } = await transpile(path, options2);
       expect(after.length).to.be.below(before.length);
     })
+    it('should embed compressed WASM when compressWASM is specified', async function() {
+      const path = getSamplePath('simple');
+      const options1 = { optimize: 'Debug' };
+      const options2 = { optimize: 'Debug', compressWASM: true };
+      const { code: before } = await transpile(path, options1);
+      const { code: after } = await transpile(path, options2);
+      expect(after).to.contain('DecompressionStream');
+      expect(after.length).to.be.below(before.length);
+    })
+    it('should report size and startup time of embedding modes when reportEmbedding is specified', async function() {
+      const path = getSamplePath('simple');
+      const options = { optimize: 'Debug', reportEmbedding: true };
+      const { embeddingReport } = await transpile(path, options);
+      expect(embeddingReport).to.have.lengthOf(2);
+      const [ base64, gzip ] = embeddingReport;
+      expect(base64).to.include({ mode: 'base64' });
+      expect(gzip).to.include({ mode: 'gzip' });
+      expect(gzip.size).to.be.below(base64.size);
+      expect(gzip.startupTime).to.be.a('number');
+    })
     it('should call wasmLoader when embedWASM is false', async function() {
       const path = getSamplePath('simple');
       let srcPath, wasmDV;
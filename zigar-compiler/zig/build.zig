@@ -115,6 +115,7 @@ pub fn build(b: *std.Build) !void {
     options.addOption(comptime_int, "eval_branch_quota", cfg.eval_branch_quota);
     options.addOption(bool, "omit_functions", cfg.omit_functions);
     options.addOption(bool, "omit_variables", cfg.omit_variables);
+    options.addOption(?[]const []const u8, "used_exports", cfg.used_exports);
     options.addOption(bool, "use_redirection", cfg.use_redirection);
     options.addOption(bool, "use_pthread_emulation", cfg.use_pthread_emulation);
     options.addOption([:0]const u8, "module_path", cfg.module_path);
@@ -345,6 +345,15 @@ fn Factory(comptime host: type, comptime module: type) type {
             };
         }
 
+        fn isExportUsed(comptime T: type, comptime name: []const u8) bool {
+            // only declarations of the root module are filtered
+            if (T != module or !@hasDecl(options, "used_exports")) return true;
+            const names = options.used_exports orelse return true;
+            return for (names) |used_name| {
+                if (std.mem.eql(u8, used_name, name)) break true;
+            } else false;
+        }
+
         // NOTE: anyerror has to be used here since the function is called recursively
         // and https://github.com/ziglang/zig/issues/2971 has not been fully resolved yet
         fn getStructure(self: @This(), comptime T: type) anyerror!Value {
@@ -780,7 +789,7 @@ fn Factory(comptime host: type, comptime module: type) type {
                                 type => supported.is(decl_value),
                                 else => true,
                             };
-                            const should_export = if (is_value_supported) switch (@typeInfo(DT)) {
+                            const should_export = if (is_value_supported and isExportUsed(T, decl.name)) switch (@typeInfo(DT)) {
                                 .@"fn" => !options.omit_functions,
                                 else => !options.omit_variables or @typeInfo(PT).pointer.is_const,
                             } else false;
@@ -862,7 +871,7 @@ fn Factory(comptime host: type, comptime module: type) type {
                                 type => supported.is(decl_value),
                                 else => true,
                             };
-                            const should_export = if (is_value_supported) switch (@typeInfo(DT)) {
+                            const should_export = if (is_value_supported and isExportUsed(T, decl.name)) switch (@typeInfo(DT)) {
                                 .@"fn" => !options.omit_functions,
                                 else => !options.omit_variables or @typeInfo(PT).pointer.is_const,
                             } else false;
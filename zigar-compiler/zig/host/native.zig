@@ -219,11 +219,21 @@ pub fn redirectIO(fn_ptr: *const anyopaque) !void {
     if (imports.redirect_syscalls(instance, fn_ptr) != .SUCCESS) return error.UnableToRedirectIo;
 }
 
+pub const OutputStats = hooks.OutputStats;
+
+pub fn getOutputStats() OutputStats {
+    return hooks.getOutputStats();
+}
+
+pub fn flushOutput() void {
+    hooks.flushOutput(@This());
+}
+
 pub fn getInstance() *anyopaque {
     return instance;
 }
 
-pub fn setHostInstance(ptr: *Module.Host) callconv(.c) E {
+pub fn setHostInstance(ptr: ?*Module.Host) callconv(.c) E {
     if (builtin.link_libc and builtin.target.os.tag != .windows) {
         if (@hasDecl(c, "RTLD_DEEPBIND")) {
             // fix missing environ due to RTLD_DEEPBIND option given to dlopen()
@@ -236,8 +246,13 @@ pub fn setHostInstance(ptr: *Module.Host) callconv(.c) E {
             }
         }
     }
-    instance = ptr;
-    initialized = true;
+    // the host clears its pointer when it goes away while the library stays loaded
+    if (ptr) |host| {
+        instance = host;
+        initialized = true;
+    } else {
+        initialized = false;
+    }
     return E.SUCCESS;
 }
 
@@ -384,7 +399,7 @@ pub fn isRedirectingStderr() bool {
 
 pub fn isRedirecting(comptime literal: @TypeOf(.enum_literal)) bool {
     if (!exporter.options.use_redirection) unreachable;
-    if (redirection_suppressed) return false;
+    if (redirection_suppressed or !initialized) return false;
     var mask: hooks.Syscall.Mask = undefined;
     if (imports.get_syscall_mask(instance, &mask) != .SUCCESS) return false;
     if (literal == .any) {
@@ -454,6 +469,10 @@ test "createModule" {
 }
 
 pub fn panic(msg: []const u8, _: ?*std.builtin.StackTrace, ret_addr: ?usize) noreturn {
+    const first = !redirection_suppressed;
     redirection_suppressed = true;
+    // send out what the thread has printed so far, so that it appears ahead of the panic message;
+    // skip it when we're panicking again, in case it's the flushing that failed
+    if (first) flushOutput();
     std.debug.defaultPanic(msg, ret_addr);
 }
@@ -493,6 +493,8 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
 
         pub fn close(fd: c_int, result: *c_int) callconv(.c) bool {
             if (isPrivateDescriptor(fd)) {
+                // keep combined output in order
+                output.flush(fd);
                 var call: Syscall = .{ .cmd = .close, .u = .{
                     .close = .{
                         .fd = @intCast(fd),
@@ -749,6 +751,7 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
 
         pub fn fdatasync(fd: c_int, result: *c_int) callconv(.c) bool {
             if (isPrivateDescriptor(fd)) {
+                output.flush(fd);
                 var call: Syscall = .{ .cmd = .datasync, .u = .{
                     .datasync = .{
                         .fd = @intCast(fd),
@@ -875,6 +878,7 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
 
         pub fn fsync(fd: c_int, result: *c_int) callconv(.c) bool {
             if (isPrivateDescriptor(fd)) {
+                output.flush(fd);
                 var call: Syscall = .{ .cmd = .sync, .u = .{
                     .sync = .{
                         .fd = @intCast(fd),
@@ -1367,6 +1371,7 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
 
         fn pwriteT(comptime T: type, fd: c_int, buffer: [*]const u8, len: T, offset: T, result: *T) bool {
             if (isPrivateDescriptor(fd)) {
+                output.flush(fd);
                 var call: Syscall = .{ .cmd = .pwrite, .u = .{
                     .pwrite = .{
                         .fd = @intCast(fd),
@@ -1392,6 +1397,7 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
 
         fn pwritevT(comptime T: type, fd: c_int, iovs: [*]const std.c.iovec_const, count: c_int, offset: T, result: *T) bool {
             if (isPrivateDescriptor(fd)) {
+                output.flush(fd);
                 var call: Syscall = .{ .cmd = .pwritev, .u = .{
                     .pwritev = .{
                         .fd = @intCast(fd),
@@ -1707,6 +1713,10 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
 
         pub fn write(fd: c_int, buffer: [*]const u8, len: off_t, result: *off_t) callconv(.c) bool {
             if (isPrivateDescriptor(fd)) {
+                if ((fd == 1 or fd == 2) and output.combine(fd, buffer[0..@intCast(len)])) {
+                    result.* = len;
+                    return true;
+                }
                 var call: Syscall = .{ .cmd = .write, .u = .{
                     .write = .{
                         .fd = @intCast(fd),
@@ -1723,6 +1733,12 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
 
         pub fn writev(fd: c_int, iovs: [*]const std.c.iovec_const, count: c_int, result: *off_t) callconv(.c) bool {
             if (isPrivateDescriptor(fd)) {
+                if (fd == 1 or fd == 2) {
+                    if (output.combineVector(fd, iovs[0..@intCast(count)])) |len| {
+                        result.* = @intCast(len);
+                        return true;
+                    }
+                }
                 var call: Syscall = .{ .cmd = .writev, .u = .{
                     .writev = .{
                         .fd = @intCast(fd),
@@ -1738,6 +1754,7 @@ pub fn SyscallRedirector(comptime ModuleHost: type) type {
         }
 
         const Host = ModuleHost;
+        const output = OutputCombiner(Host);
 
         fn isPrivateDescriptor(fd: c_int) bool {
             return switch (fd) {
@@ -2573,6 +2590,221 @@ pub fn PosixSubstituteDarwin(comptime redirector: type) type {
     };
 }
 
+pub const OutputStats = struct {
+    writes: usize = 0,
+    flushes: usize = 0,
+    bytes: usize = 0,
+};
+var output_writes: std.atomic.Value(usize) = .init(0);
+var output_flushes: std.atomic.Value(usize) = .init(0);
+var output_bytes: std.atomic.Value(usize) = .init(0);
+
+pub fn getOutputStats() OutputStats {
+    return .{
+        .writes = output_writes.load(.monotonic),
+        .flushes = output_flushes.load(.monotonic),
+        .bytes = output_bytes.load(.monotonic),
+    };
+}
+
+pub fn flushOutput(comptime Host: type) void {
+    OutputCombiner(Host).flushAll();
+}
+
+// writes to stdout and stderr from threads started by the module are gathered in per-thread
+// buffers, so that code printing line by line does not cost a trip to the main thread per line;
+// buffers are flushed when full, on newline once the oldest byte is older than the interval, on
+// fflush(), when the thread ends, or by a background thread that wakes up every interval
+fn OutputCombiner(comptime Host: type) type {
+    return struct {
+        const capacity = 4096;
+        const interval_ms = 20;
+
+        const Channel = struct {
+            len: usize = 0,
+            since: i64 = 0,
+            bytes: [capacity]u8 = undefined,
+        };
+        const Node = struct {
+            next: ?*Node = null,
+            in_use: std.atomic.Value(bool) = .init(true),
+            mutex: std.Thread.Mutex = .{},
+            // fd 1 and fd 2
+            channels: [2]Channel = .{ .{}, .{} },
+        };
+        const Flusher = struct {
+            thread: std.Thread = undefined,
+            stop: std.Thread.ResetEvent = .{},
+        };
+
+        // nodes are never freed; they get picked up by threads started later
+        var head: std.atomic.Value(?*Node) = .init(null);
+        var control_mutex: std.Thread.Mutex = .{};
+        var active_count: usize = 0;
+        var flusher: ?*Flusher = null;
+
+        threadlocal var enabled: bool = false;
+        threadlocal var current: ?*Node = null;
+
+        pub fn enable() void {
+            enabled = true;
+        }
+
+        pub fn release() void {
+            const node = current orelse return;
+            flushNode(node);
+            current = null;
+            node.in_use.store(false, .release);
+            control_mutex.lock();
+            active_count -= 1;
+            const stopping = if (active_count == 0) flusher else null;
+            if (stopping != null) flusher = null;
+            control_mutex.unlock();
+            if (stopping) |f| {
+                // make sure the flusher is gone before the last thread is, since the host might
+                // go away afterward
+                f.stop.set();
+                f.thread.join();
+                c_allocator.destroy(f);
+            }
+        }
+
+        pub fn combine(fd: c_int, bytes: []const u8) bool {
+            const iovs: [1]std.c.iovec_const = .{.{ .base = bytes.ptr, .len = bytes.len }};
+            return combineVector(fd, &iovs) != null;
+        }
+
+        pub fn combineVector(fd: c_int, iovs: []const std.c.iovec_const) ?usize {
+            if (!enabled) return null;
+            var total: usize = 0;
+            for (iovs) |iov| total += iov.len;
+            if (total == 0) return null;
+            const node = current orelse acquire() orelse return null;
+            node.mutex.lock();
+            defer node.mutex.unlock();
+            const channel = &node.channels[@intCast(fd - 1)];
+            if (channel.len + total > capacity) flushChannel(fd, channel);
+            // write that wouldn't fit is performed directly, after what came before it
+            if (total > capacity) return null;
+            if (channel.len == 0) channel.since = std.time.milliTimestamp();
+            for (iovs) |iov| {
+                @memcpy(channel.bytes[channel.len .. channel.len + iov.len], iov.base[0..iov.len]);
+                channel.len += iov.len;
+            }
+            _ = output_writes.fetchAdd(1, .monotonic);
+            if (channel.bytes[channel.len - 1] == '\n' and std.time.milliTimestamp() - channel.since >= interval_ms) {
+                flushChannel(fd, channel);
+            }
+            return total;
+        }
+
+        pub fn flush(fd: c_int) void {
+            if (fd != 1 and fd != 2) return;
+            const node = current orelse return;
+            node.mutex.lock();
+            defer node.mutex.unlock();
+            flushChannel(fd, &node.channels[@intCast(fd - 1)]);
+        }
+
+        pub fn flushAll() void {
+            const node = current orelse return;
+            flushNode(node);
+        }
+
+        fn flushNode(node: *Node) void {
+            node.mutex.lock();
+            defer node.mutex.unlock();
+            for (&node.channels, 1..) |*channel, fd| flushChannel(@intCast(fd), channel);
+        }
+
+        fn flushChannel(fd: c_int, channel: *Channel) void {
+            if (channel.len == 0) return;
+            var offset: usize = 0;
+            while (offset < channel.len) {
+                var call: Syscall = .{ .cmd = .write, .u = .{
+                    .write = .{
+                        .fd = @intCast(fd),
+                        .bytes = channel.bytes[offset..].ptr,
+                        .len = @intCast(channel.len - offset),
+                    },
+                } };
+                if (Host.redirectSyscall(&call) != .SUCCESS or call.u.write.written == 0) break;
+                offset += call.u.write.written;
+            }
+            channel.len = 0;
+            _ = output_flushes.fetchAdd(1, .monotonic);
+            _ = output_bytes.fetchAdd(offset, .monotonic);
+        }
+
+        fn acquire() ?*Node {
+            const node = reuseNode() orelse createNode() orelse return null;
+            control_mutex.lock();
+            defer control_mutex.unlock();
+            if (flusher == null) {
+                flusher = startFlusher() catch {
+                    // without the timer, output could linger indefinitely; write directly instead
+                    node.in_use.store(false, .release);
+                    return null;
+                };
+            }
+            active_count += 1;
+            current = node;
+            return node;
+        }
+
+        fn reuseNode() ?*Node {
+            var next = head.load(.acquire);
+            while (next) |node| : (next = node.next) {
+                if (node.in_use.cmpxchgStrong(false, true, .acquire, .monotonic) == null) return node;
+            }
+            return null;
+        }
+
+        fn createNode() ?*Node {
+            const node = c_allocator.create(Node) catch return null;
+            node.* = .{};
+            var first = head.load(.monotonic);
+            while (true) {
+                node.next = first;
+                first = head.cmpxchgWeak(first, node, .release, .monotonic) orelse break;
+            }
+            return node;
+        }
+
+        fn startFlusher() !*Flusher {
+            const f = try c_allocator.create(Flusher);
+            errdefer c_allocator.destroy(f);
+            f.* = .{};
+            // thread is started through the hooked function, so it's known to the host
+            f.thread = try std.Thread.spawn(.{}, runFlusher, .{f});
+            return f;
+        }
+
+        fn runFlusher(f: *Flusher) void {
+            while (true) {
+                f.stop.timedWait(interval_ms * std.time.ns_per_ms) catch {
+                    flushAged();
+                    continue;
+                };
+                break;
+            }
+        }
+
+        fn flushAged() void {
+            const now = std.time.milliTimestamp();
+            var next = head.load(.acquire);
+            while (next) |node| : (next = node.next) {
+                if (!node.in_use.load(.acquire)) continue;
+                node.mutex.lock();
+                defer node.mutex.unlock();
+                for (&node.channels, 1..) |*channel, fd| {
+                    if (channel.len > 0 and now - channel.since >= interval_ms) flushChannel(@intCast(fd), channel);
+                }
+            }
+        }
+    };
+}
+
 pub fn PthreadSubstitute(comptime redirector: type) type {
     return struct {
         pub fn pthread_create(thread: *std.c.pthread_t, attr: ?*const std.c.pthread_attr_t, start_routine: *const fn (?*anyopaque) callconv(.c) ?*anyopaque, arg: ?*anyopaque) callconv(.c) c_int {
@@ -2594,6 +2826,8 @@ pub fn PthreadSubstitute(comptime redirector: type) type {
             c_allocator.destroy(info);
             redirector.Host.initializeThread(instance) catch unreachable;
             defer redirector.Host.deinitializeThread(instance) catch {};
+            redirector.output.enable();
+            defer redirector.output.release();
             return proc(arg);
         }
 
@@ -2645,6 +2879,8 @@ pub fn PthreadSubsituteWindows(comptime redirector: type) type {
             c_allocator.destroy(info);
             redirector.Host.initializeThread(instance) catch unreachable;
             defer redirector.Host.deinitializeThread(instance) catch {};
+            redirector.output.enable();
+            defer redirector.output.release();
             proc(arg);
         }
 
@@ -2656,6 +2892,8 @@ pub fn PthreadSubsituteWindows(comptime redirector: type) type {
             c_allocator.destroy(info);
             redirector.Host.initializeThread(instance) catch unreachable;
             defer redirector.Host.deinitializeThread(instance) catch {};
+            redirector.output.enable();
+            defer redirector.output.release();
             return proc(arg);
         }
 
@@ -2853,12 +3091,15 @@ pub fn LibcSubstitute(comptime redirector: type) type {
         pub fn fflush(arg: ?*std.c.FILE) callconv(.c) c_int {
             if (arg) |s| {
                 if (getRedirectedFile(s)) |file| {
+                    // send out what the combiner has gathered too
+                    defer redirector.output.flush(file.fd);
                     return if (flush(file) < 0) -1 else 0;
                 }
                 return Original.ferror(s);
             } else {
                 const stdin = getStdProxy(0);
                 const stdout = getStdProxy(1);
+                defer redirector.output.flushAll();
                 if (flush(stdin) < 0) return -1;
                 if (flush(stdout) < 0) return -1;
                 for (RedirectedFile.list.items) |file| {
@@ -5145,6 +5386,8 @@ pub fn Win32SubstituteNonIO(comptime redirector: type) type {
             c_allocator.destroy(info);
             redirector.Host.initializeThread(instance) catch unreachable;
             defer redirector.Host.deinitializeThread(instance) catch {};
+            redirector.output.enable();
+            defer redirector.output.release();
             return proc(arg);
         }
 
@@ -138,6 +138,19 @@ pub fn redirectIO(_: *const anyopaque) !void {
     return error.NoSupport;
 }
 
+pub const OutputStats = struct {
+    writes: usize = 0,
+    flushes: usize = 0,
+    bytes: usize = 0,
+};
+
+pub fn getOutputStats() OutputStats {
+    // output isn't combined in WebAssembly
+    return .{};
+}
+
+pub fn flushOutput() void {}
+
 const empty_ptr: *anyopaque = @ptrCast(@constCast(&.{}));
 
 export fn runThunk(
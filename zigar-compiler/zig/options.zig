@@ -1,5 +1,6 @@
 pub const omit_functions = false;
 pub const omit_variables = false;
+pub const used_exports: ?[]const []const u8 = null;
 pub const eval_branch_quota = 2000000;
 pub const setStorage_redirection = true;
 pub const setStorage_pthread_emulation = true;
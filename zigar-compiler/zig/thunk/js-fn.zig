@@ -69,11 +69,14 @@ pub fn createThunkController(comptime host: type, comptime BFT: type) ThunkContr
         true => struct {
             const count = 16;
 
-            var fn_ids: [count]usize = init: {
-                var array: [count]usize = undefined;
-                for (&array) |*ptr| ptr.* = 0;
+            var fn_ids: [count]usize = @splat(0);
+            // indices of unused thunks, most recently freed on top
+            var free_list: [count]u8 = init: {
+                var array: [count]u8 = undefined;
+                for (&array, 0..) |*ptr, index| ptr.* = count - 1 - index;
                 break :init array;
             };
+            var free_count: usize = count;
             const thunks: [count]*const BFT = init: {
                 const CHT = CallHandler(BFT);
                 const ch = @typeInfo(CHT).@"fn";
@@ -100,33 +103,34 @@ pub fn createThunkController(comptime host: type, comptime BFT: type) ThunkContr
             fn control(action: Action, arg: usize) !usize {
                 switch (action) {
                     .create => {
-                        const fn_id = arg;
-                        return for (&fn_ids, 0..) |*ptr, index| {
-                            if (ptr.* == 0) {
-                                ptr.* = fn_id;
-                                break @intFromPtr(thunks[index]);
-                            }
-                        } else Error.UnableToCreateThunk;
+                        // JavaScript would provide a thunk from another instance when we run out
+                        if (free_count == 0) return Error.UnableToCreateThunk;
+                        free_count -= 1;
+                        const index = free_list[free_count];
+                        fn_ids[index] = arg;
+                        return @intFromPtr(thunks[index]);
                     },
                     .destroy => {
-                        const thunk: *const BFT = @ptrFromInt(arg);
-                        return for (thunks, &fn_ids) |f, *id_ptr| {
-                            if (f == thunk) {
-                                defer id_ptr.* = 0;
-                                break id_ptr.*;
-                            }
-                        } else Error.UnableToFindThunk;
+                        const index = try findThunk(arg);
+                        const fn_id = fn_ids[index];
+                        fn_ids[index] = 0;
+                        free_list[free_count] = @intCast(index);
+                        free_count += 1;
+                        return fn_id;
                     },
                     .identify => {
-                        const thunk: *const BFT = @ptrFromInt(arg);
-                        return for (thunks, &fn_ids) |f, *id_ptr| {
-                            if (f == thunk) {
-                                break id_ptr.*;
-                            }
-                        } else Error.UnableToFindThunk;
+                        const index = try findThunk(arg);
+                        return fn_ids[index];
                     },
                 }
             }
+
+            fn findThunk(address: usize) !usize {
+                const thunk: *const BFT = @ptrFromInt(address);
+                return for (thunks, 0..) |f, index| {
+                    if (f == thunk and fn_ids[index] != 0) break index;
+                } else Error.UnableToFindThunk;
+            }
         },
     };
     return &tc_ns.control;
@@ -151,6 +155,28 @@ test "createThunkController" {
     try expectEqual(1234, result);
 }
 
+test "createThunkController (recycling)" {
+    const BFT = fn (i32) usize;
+    const host = struct {
+        fn handleJscall(fn_id: usize, arg_ptr: *anyopaque, _: usize) E {
+            @as(*ArgStruct(BFT), @ptrCast(@alignCast(arg_ptr))).retval = fn_id;
+            return .SUCCESS;
+        }
+    };
+    const tc = createThunkController(host, BFT);
+    const address1 = try tc(.create, 1);
+    const address2 = try tc(.create, 2);
+    try expect(address1 != address2);
+    try expectEqual(1, try tc(.identify, address1));
+    try expectEqual(1, try tc(.destroy, address1));
+    const address3 = try tc(.create, 3);
+    const thunk: *const BFT = @ptrFromInt(address3);
+    try expectEqual(3, thunk(0));
+    try expectEqual(2, try tc(.identify, address2));
+    _ = try tc(.destroy, address2);
+    _ = try tc(.destroy, address3);
+}
+
 fn CallHandler(comptime BFT: type) type {
     const f = @typeInfo(BFT).@"fn";
     var new_params: [f.params.len + 2]std.builtin.Type.Fn.Param = undefined;
@@ -150,6 +150,100 @@ pub fn WebImage(acc: Access, format: PixelFormat) type {
         pub fn sampleLinear(self: *const @This(), comptime T: type, coord: Coord(T)) T {
             return Super.sampleLinear(self, T, coord);
         }
+
+        pub fn getPixels(self: *const @This(), comptime T: type, comptime n: usize, x: usize, y: usize) Lanes(T, n) {
+            return Super.getPixels(self, T, n, x, y);
+        }
+
+        pub fn setPixels(self: *const @This(), comptime T: type, comptime n: usize, x: usize, y: usize, lanes: Lanes(T, n)) void {
+            return Super.setPixels(self, T, n, x, y, lanes);
+        }
+
+        pub fn getRow(self: *const @This(), comptime T: type, x: usize, y: usize, pixels: []T) void {
+            return Super.getRow(self, T, x, y, pixels);
+        }
+
+        pub fn setRow(self: *const @This(), comptime T: type, x: usize, y: usize, pixels: []const T) void {
+            return Super.setRow(self, T, x, y, pixels);
+        }
+
+        pub fn getBlock(self: *const @This(), comptime T: type, x: usize, y: usize, width: usize, pixels: []T) void {
+            return Super.getBlock(self, T, x, y, width, pixels);
+        }
+
+        pub fn setBlock(self: *const @This(), comptime T: type, x: usize, y: usize, width: usize, pixels: []const T) void {
+            return Super.setBlock(self, T, x, y, width, pixels);
+        }
+
+        pub fn sampleNearestN(self: *const @This(), comptime T: type, comptime n: usize, coords: Coords(T, n)) Lanes(T, n) {
+            return Super.sampleNearestN(self, T, n, coords);
+        }
+
+        pub fn sampleLinearN(self: *const @This(), comptime T: type, comptime n: usize, coords: Coords(T, n)) Lanes(T, n) {
+            return Super.sampleLinearN(self, T, n, coords);
+        }
+
+        // raw pixel access used by bulk operations; pixels outside the image are zero when read
+        // and are skipped when written
+
+        const Raw = Pixel;
+
+        fn readRaw(self: *const @This(), comptime n: usize, x: usize, y: usize) [n]Raw {
+            const index = (y * self.width) + x;
+            const count = @min(n, self.width -| x);
+            if (runtime_safety and count > 0 and index + count > self.data.len) {
+                @panic("Mismatch between data length and image dimensions");
+            }
+            if (count == n) return self.data[index..][0..n].*;
+            var raw = std.mem.zeroes([n]Raw);
+            @memcpy(raw[0..count], self.data[index..][0..count]);
+            return raw;
+        }
+
+        fn writeRaw(self: *const @This(), comptime n: usize, x: usize, y: usize, len: usize, raw: [n]Raw) void {
+            if (acc == .ro) unreachable;
+            const index = (y * self.width) + x;
+            const count = @min(len, self.width -| x);
+            if (runtime_safety and count > 0 and index + count > self.data.len) {
+                @panic("Mismatch between data length and image dimensions");
+            }
+            @memcpy(self.data[index..][0..count], raw[0..count]);
+        }
+
+        fn fetchRaw(self: *const @This(), comptime n: usize, xs: @Vector(n, u32), ys: @Vector(n, u32), valid: @Vector(n, bool)) [n]Raw {
+            var raw: [n]Raw = undefined;
+            inline for (0..n) |i| {
+                raw[i] = if (valid[i]) self.data[(@as(usize, ys[i]) * self.width) + xs[i]] else .{ 0, 0, 0, 0 };
+            }
+            return raw;
+        }
+
+        fn decode(comptime E: type, comptime n: usize, raw: [n]Raw) RGBA(E, n) {
+            return switch (format) {
+                .@"rgba-unorm8" => convert: {
+                    const bytes: @Vector(n * 4, u8) = @bitCast(raw);
+                    const multiplier: @Vector(n, E) = @splat(1.0 / @as(E, @floatFromInt(std.math.maxInt(u8))));
+                    var rgba: RGBA(E, n) = undefined;
+                    inline for (0..4) |c| {
+                        const ints = @shuffle(u8, bytes, undefined, comptime strideMask(n, c, 4));
+                        rgba[c] = @as(@Vector(n, E), @floatFromInt(ints)) * multiplier;
+                    }
+                    break :convert rgba;
+                },
+            };
+        }
+
+        fn encode(comptime E: type, comptime n: usize, rgba: RGBA(E, n)) [n]Raw {
+            return switch (format) {
+                .@"rgba-unorm8" => convert: {
+                    const max: @Vector(n, E) = @splat(@floatFromInt(std.math.maxInt(u8)));
+                    var ints: [4]@Vector(n, u8) = undefined;
+                    inline for (0..4) |c| ints[c] = @intFromFloat(clamp(E, n, rgba[c] * max, max));
+                    const bytes = interleave(u8, n, ints);
+                    break :convert @bitCast(bytes);
+                },
+            };
+        }
     };
 }
 
@@ -275,6 +369,138 @@ pub fn GdImage(acc: Access) type {
             return Super.sampleLinear(self, T, coord);
         }
 
+        pub fn getPixels(self: *const @This(), comptime T: type, comptime n: usize, x: usize, y: usize) Lanes(T, n) {
+            return Super.getPixels(self, T, n, x, y);
+        }
+
+        pub fn setPixels(self: *const @This(), comptime T: type, comptime n: usize, x: usize, y: usize, lanes: Lanes(T, n)) void {
+            return Super.setPixels(self, T, n, x, y, lanes);
+        }
+
+        pub fn getRow(self: *const @This(), comptime T: type, x: usize, y: usize, pixels: []T) void {
+            return Super.getRow(self, T, x, y, pixels);
+        }
+
+        pub fn setRow(self: *const @This(), comptime T: type, x: usize, y: usize, pixels: []const T) void {
+            return Super.setRow(self, T, x, y, pixels);
+        }
+
+        pub fn getBlock(self: *const @This(), comptime T: type, x: usize, y: usize, width: usize, pixels: []T) void {
+            return Super.getBlock(self, T, x, y, width, pixels);
+        }
+
+        pub fn setBlock(self: *const @This(), comptime T: type, x: usize, y: usize, width: usize, pixels: []const T) void {
+            return Super.setBlock(self, T, x, y, width, pixels);
+        }
+
+        pub fn sampleNearestN(self: *const @This(), comptime T: type, comptime n: usize, coords: Coords(T, n)) Lanes(T, n) {
+            return Super.sampleNearestN(self, T, n, coords);
+        }
+
+        pub fn sampleLinearN(self: *const @This(), comptime T: type, comptime n: usize, coords: Coords(T, n)) Lanes(T, n) {
+            return Super.sampleLinearN(self, T, n, coords);
+        }
+
+        // raw pixel access used by bulk operations; pixels outside the image are zero when read
+        // and are skipped when written
+
+        const Raw = c_int;
+
+        fn readRaw(self: *const @This(), comptime n: usize, x: usize, y: usize) [n]Raw {
+            const im = self.cast();
+            const count = @min(n, self.getWidth() -| x);
+            var raw = std.mem.zeroes([n]Raw);
+            if (count == 0) return raw;
+            if (runtime_safety and y >= self.getHeight()) {
+                @panic("Mismatch between data length and image dimensions");
+            }
+            if (im.tpixels) |tpixels| {
+                const row = tpixels[y];
+                if (count == n) return row[x..][0..n].*;
+                @memcpy(raw[0..count], row[x..][0..count]);
+            } else if (im.pixels) |pixels| {
+                const row = pixels[y];
+                for (0..count) |i| raw[i] = self.getPaletteColor(row[x + i]);
+            }
+            return raw;
+        }
+
+        fn writeRaw(self: *const @This(), comptime n: usize, x: usize, y: usize, len: usize, raw: [n]Raw) void {
+            if (acc == .ro) unreachable;
+            const im = self.cast();
+            const count = @min(len, self.getWidth() -| x);
+            if (count == 0) return;
+            if (runtime_safety and y >= self.getHeight()) {
+                @panic("Mismatch between data length and image dimensions");
+            }
+            if (im.tpixels) |tpixels| {
+                @memcpy(tpixels[y][x..][0..count], raw[0..count]);
+            } else if (im.pixels) |pixels| {
+                const row = pixels[y];
+                for (0..count) |i| {
+                    const color = raw[i];
+                    row[x + i] = self.findClosestPaletteColor(
+                        component(color, 0x00FF0000, 16),
+                        component(color, 0x0000FF00, 8),
+                        component(color, 0x000000FF, 0),
+                        component(color, 0x7F000000, 24),
+                    );
+                }
+            }
+        }
+
+        fn fetchRaw(self: *const @This(), comptime n: usize, xs: @Vector(n, u32), ys: @Vector(n, u32), valid: @Vector(n, bool)) [n]Raw {
+            const im = self.cast();
+            var raw: [n]Raw = undefined;
+            inline for (0..n) |i| {
+                if (runtime_safety and valid[i] and (xs[i] >= self.getWidth() or ys[i] >= self.getHeight())) {
+                    @panic("Mismatch between data length and image dimensions");
+                }
+                raw[i] = if (!valid[i])
+                    0
+                else if (im.tpixels) |tpixels|
+                    tpixels[ys[i]][xs[i]]
+                else if (im.pixels) |pixels|
+                    self.getPaletteColor(pixels[ys[i]][xs[i]])
+                else
+                    unreachable;
+            }
+            return raw;
+        }
+
+        fn decode(comptime E: type, comptime n: usize, raw: [n]Raw) RGBA(E, n) {
+            const U = @Vector(n, u32);
+            const colors: U = @bitCast(raw);
+            const mask_u8: U = @splat(0xFF);
+            const mask_u7: U = @splat(0x7F);
+            const r = (colors >> @splat(16)) & mask_u8;
+            const g = (colors >> @splat(8)) & mask_u8;
+            const b = colors & mask_u8;
+            // alpha channel is only 7-bit, with 0 being opaque
+            const a = mask_u7 - ((colors >> @splat(24)) & mask_u7);
+            const multiplier_u8: @Vector(n, E) = @splat(1.0 / @as(E, @floatFromInt(std.math.maxInt(u8))));
+            const multiplier_u7: @Vector(n, E) = @splat(1.0 / @as(E, @floatFromInt(std.math.maxInt(u7))));
+            return .{
+                @as(@Vector(n, E), @floatFromInt(r)) * multiplier_u8,
+                @as(@Vector(n, E), @floatFromInt(g)) * multiplier_u8,
+                @as(@Vector(n, E), @floatFromInt(b)) * multiplier_u8,
+                @as(@Vector(n, E), @floatFromInt(a)) * multiplier_u7,
+            };
+        }
+
+        fn encode(comptime E: type, comptime n: usize, rgba: RGBA(E, n)) [n]Raw {
+            const U = @Vector(n, u32);
+            const max_u8: @Vector(n, E) = @splat(@floatFromInt(std.math.maxInt(u8)));
+            const max_u7: @Vector(n, E) = @splat(@floatFromInt(std.math.maxInt(u7)));
+            const r: U = @intFromFloat(clamp(E, n, rgba[0] * max_u8, max_u8));
+            const g: U = @intFromFloat(clamp(E, n, rgba[1] * max_u8, max_u8));
+            const b: U = @intFromFloat(clamp(E, n, rgba[2] * max_u8, max_u8));
+            const a: U = @intFromFloat(clamp(E, n, rgba[3] * max_u7, max_u7));
+            const t = @as(U, @splat(0x7F)) - a;
+            const colors = (r << @splat(16)) | (g << @splat(8)) | b | (t << @splat(24));
+            return @bitCast(colors);
+        }
+
         inline fn component(color: c_int, mask: c_uint, comptime shift: u6) u8 {
             const value: c_uint = @bitCast(color);
             return @truncate((value & mask) >> shift);
@@ -400,8 +626,170 @@ fn Coord(comptime T: type) type {
     return @Vector(2, Child(T));
 }
 
+/// Pixels in a bulk operation, one vector of n values per channel
+pub fn Lanes(comptime T: type, comptime n: usize) type {
+    return [channels(T)]@Vector(n, Child(T));
+}
+
+fn Coords(comptime T: type, comptime n: usize) type {
+    return [2]@Vector(n, Child(T));
+}
+
+fn RGBA(comptime E: type, comptime n: usize) type {
+    return [4]@Vector(n, E);
+}
+
+fn strideMask(comptime n: usize, comptime offset: usize, comptime stride: usize) @Vector(n, i32) {
+    var mask: @Vector(n, i32) = undefined;
+    for (0..n) |i| mask[i] = @intCast(i * stride + offset);
+    return mask;
+}
+
+fn interleaveMask(comptime n: usize, comptime width: usize) @Vector(n * 2, i32) {
+    // take width items from a, then width items from b, and so on
+    var mask: @Vector(n * 2, i32) = undefined;
+    for (0..n / width) |i| {
+        for (0..width) |j| {
+            mask[i * width * 2 + j] = @intCast(i * width + j);
+            mask[i * width * 2 + width + j] = ~@as(i32, @intCast(i * width + j));
+        }
+    }
+    return mask;
+}
+
+fn interleave(comptime E: type, comptime n: usize, vectors: [4]@Vector(n, E)) @Vector(n * 4, E) {
+    const rg = @shuffle(E, vectors[0], vectors[1], comptime interleaveMask(n, 1));
+    const ba = @shuffle(E, vectors[2], vectors[3], comptime interleaveMask(n, 1));
+    return @shuffle(E, rg, ba, comptime interleaveMask(n * 2, 2));
+}
+
+inline fn clamp(comptime E: type, comptime n: usize, vector: @Vector(n, E), max: @Vector(n, E)) @Vector(n, E) {
+    const min: @Vector(n, E) = @splat(0.0);
+    // apply maximum constraint
+    const vector_wo_min = @select(E, vector < max, vector, max);
+    // apply minimum constraint
+    return @select(E, vector_wo_min > min, vector_wo_min, min);
+}
+
 fn Parent(comptime Self: type) type {
     return struct {
+        inline fn getPixels(self: *const Self, comptime T: type, comptime n: usize, x: usize, y: usize) Lanes(T, n) {
+            const rgba = Self.decode(Child(T), n, self.readRaw(n, x, y));
+            return toLanes(T, n, rgba);
+        }
+
+        inline fn setPixels(self: *const Self, comptime T: type, comptime n: usize, x: usize, y: usize, lanes: Lanes(T, n)) void {
+            storePixels(self, T, n, x, y, n, lanes);
+        }
+
+        inline fn storePixels(self: *const Self, comptime T: type, comptime n: usize, x: usize, y: usize, count: usize, lanes: Lanes(T, n)) void {
+            const raw = Self.encode(Child(T), n, fromLanes(T, n, lanes));
+            self.writeRaw(n, x, y, count, raw);
+        }
+
+        inline fn getRow(self: *const Self, comptime T: type, x: usize, y: usize, pixels: []T) void {
+            const n = chunkLength(T);
+            var i: usize = 0;
+            while (i < pixels.len) : (i += n) {
+                const lanes = getPixels(self, T, n, x + i, y);
+                inline for (0..n) |j| {
+                    if (i + j < pixels.len) {
+                        inline for (0..channels(T)) |c| pixels[i + j][c] = lanes[c][j];
+                    }
+                }
+            }
+        }
+
+        inline fn setRow(self: *const Self, comptime T: type, x: usize, y: usize, pixels: []const T) void {
+            const n = chunkLength(T);
+            var i: usize = 0;
+            while (i < pixels.len) : (i += n) {
+                var lanes = std.mem.zeroes(Lanes(T, n));
+                inline for (0..n) |j| {
+                    if (i + j < pixels.len) {
+                        inline for (0..channels(T)) |c| lanes[c][j] = pixels[i + j][c];
+                    }
+                }
+                storePixels(self, T, n, x + i, y, @min(n, pixels.len - i), lanes);
+            }
+        }
+
+        inline fn getBlock(self: *const Self, comptime T: type, x: usize, y: usize, width: usize, pixels: []T) void {
+            if (width == 0) return;
+            const height = @min(pixels.len / width, self.getHeight() -| y);
+            for (0..height) |row| getRow(self, T, x, y + row, pixels[row * width .. (row + 1) * width]);
+        }
+
+        inline fn setBlock(self: *const Self, comptime T: type, x: usize, y: usize, width: usize, pixels: []const T) void {
+            if (width == 0) return;
+            const height = @min(pixels.len / width, self.getHeight() -| y);
+            for (0..height) |row| setRow(self, T, x, y + row, pixels[row * width .. (row + 1) * width]);
+        }
+
+        inline fn sampleNearestN(self: *const Self, comptime T: type, comptime n: usize, coords: Coords(T, n)) Lanes(T, n) {
+            const E = Child(T);
+            const U = @Vector(n, u32);
+            const width: U = @splat(@intCast(self.getWidth()));
+            const height: U = @splat(@intCast(self.getHeight()));
+            // rely on integer overflow to filter out negative coordinates
+            const xs: U = @bitCast(@as(@Vector(n, i32), @intFromFloat(@floor(coords[0]))));
+            const ys: U = @bitCast(@as(@Vector(n, i32), @intFromFloat(@floor(coords[1]))));
+            const valid = @select(bool, xs < width, ys < height, @as(@Vector(n, bool), @splat(false)));
+            const rgba = Self.decode(E, n, self.fetchRaw(n, xs, ys, valid));
+            const zero: @Vector(n, E) = @splat(0);
+            var lanes = toLanes(T, n, rgba);
+            inline for (&lanes) |*lane| lane.* = @select(E, valid, lane.*, zero);
+            return lanes;
+        }
+
+        inline fn sampleLinearN(self: *const Self, comptime T: type, comptime n: usize, coords: Coords(T, n)) Lanes(T, n) {
+            const V = @Vector(n, Child(T));
+            const half: V = @splat(0.5);
+            const one: V = @splat(1);
+            const cx = coords[0] - half;
+            const cy = coords[1] - half;
+            const x0 = @floor(cx);
+            const y0 = @floor(cy);
+            const fx0 = cx - x0;
+            const fy0 = cy - y0;
+            const fx1 = one - fx0;
+            const fy1 = one - fy0;
+            const p00 = sampleNearestN(self, T, n, .{ x0, y0 });
+            const p10 = sampleNearestN(self, T, n, .{ x0 + one, y0 });
+            const p01 = sampleNearestN(self, T, n, .{ x0, y0 + one });
+            const p11 = sampleNearestN(self, T, n, .{ x0 + one, y0 + one });
+            var result: Lanes(T, n) = undefined;
+            inline for (0..channels(T)) |c| {
+                result[c] = p00[c] * fx1 * fy1 + p10[c] * fx0 * fy1 + p01[c] * fx1 * fy0 + p11[c] * fx0 * fy0;
+            }
+            return result;
+        }
+
+        fn toLanes(comptime T: type, comptime n: usize, rgba: RGBA(Child(T), n)) Lanes(T, n) {
+            return switch (channels(T)) {
+                1 => .{rgba[0]},
+                2 => .{ rgba[0], rgba[3] },
+                3 => .{ rgba[0], rgba[1], rgba[2] },
+                4 => rgba,
+                else => unreachable,
+            };
+        }
+
+        fn fromLanes(comptime T: type, comptime n: usize, lanes: Lanes(T, n)) RGBA(Child(T), n) {
+            const one: @Vector(n, Child(T)) = @splat(1);
+            return switch (channels(T)) {
+                1 => .{ lanes[0], lanes[0], lanes[0], one },
+                2 => .{ lanes[0], lanes[0], lanes[0], lanes[1] },
+                3 => .{ lanes[0], lanes[1], lanes[2], one },
+                4 => lanes,
+                else => unreachable,
+            };
+        }
+
+        fn chunkLength(comptime T: type) comptime_int {
+            return @max(4, std.simd.suggestVectorLength(Child(T)) orelse 4);
+        }
+
         inline fn sampleNearest(self: *const Self, comptime T: type, coord: Coord(T)) T {
             const width = self.getWidth();
             const height = self.getHeight();
@@ -447,3 +835,72 @@ fn channels(comptime T: type) comptime_int {
     }
     @compileError("Expecting float vector type, received: " ++ @typeName(T));
 }
+
+test "WebImage.getRow()" {
+    var data: [6][4]u8 = .{
+        .{ 0, 51, 102, 255 },
+        .{ 255, 0, 0, 255 },
+        .{ 0, 255, 0, 0 },
+        .{ 0, 0, 255, 255 },
+        .{ 10, 20, 30, 40 },
+        .{ 1, 2, 3, 4 },
+    };
+    const image: WebImage(.rw, .@"rgba-unorm8") = .{ .data = &data, .width = 3, .height = 2 };
+    const Pixel = @Vector(4, f32);
+    var row: [3]Pixel = undefined;
+    image.getRow(Pixel, 0, 1, &row);
+    for (row, 0..) |pixel, x| {
+        try std.testing.expectEqual(image.getPixel(Pixel, x, 1), pixel);
+    }
+}
+
+test "WebImage.setRow()" {
+    var data: [6][4]u8 = std.mem.zeroes([6][4]u8);
+    const image: WebImage(.rw, .@"rgba-unorm8") = .{ .data = &data, .width = 3, .height = 2 };
+    const Pixel = @Vector(3, f32);
+    const row: [2]Pixel = .{ .{ 1, 0, 0.2 }, .{ 0.5, 2, -1 } };
+    image.setRow(Pixel, 1, 0, &row);
+    var expected: [6][4]u8 = std.mem.zeroes([6][4]u8);
+    const ref_image: WebImage(.rw, .@"rgba-unorm8") = .{ .data = &expected, .width = 3, .height = 2 };
+    ref_image.setPixel(Pixel, 1, 0, row[0]);
+    ref_image.setPixel(Pixel, 2, 0, row[1]);
+    try std.testing.expectEqual(expected, data);
+}
+
+test "WebImage.setBlock()" {
+    var data: [9][4]u8 = std.mem.zeroes([9][4]u8);
+    const image: WebImage(.rw, .@"rgba-unorm8") = .{ .data = &data, .width = 3, .height = 3 };
+    const Pixel = @Vector(1, f32);
+    const block: [4]Pixel = .{ .{1}, .{1}, .{1}, .{1} };
+    image.setBlock(Pixel, 1, 1, 2, &block);
+    for (data, 0..) |pixel, index| {
+        const inside = index % 3 >= 1 and index / 3 >= 1;
+        try std.testing.expectEqual(if (inside) [4]u8{ 255, 255, 255, 255 } else [4]u8{ 0, 0, 0, 0 }, pixel);
+    }
+}
+
+test "WebImage.sampleNearestN()" {
+    var data: [4][4]u8 = .{ .{ 255, 0, 0, 255 }, .{ 0, 255, 0, 255 }, .{ 0, 0, 255, 255 }, .{ 10, 20, 30, 40 } };
+    const image: WebImage(.ro, .@"rgba-unorm8") = .{ .data = &data, .width = 2, .height = 2 };
+    const Pixel = @Vector(4, f32);
+    const xs: @Vector(4, f32) = .{ 0.5, 1.5, -0.5, 1.2 };
+    const ys: @Vector(4, f32) = .{ 0.5, 1.5, 0.5, 2.5 };
+    const lanes = image.sampleNearestN(Pixel, 4, .{ xs, ys });
+    inline for (0..4) |i| {
+        const expected = image.sampleNearest(Pixel, .{ xs[i], ys[i] });
+        inline for (0..4) |c| try std.testing.expectEqual(expected[c], lanes[c][i]);
+    }
+}
+
+test "WebImage.sampleLinearN()" {
+    var data: [4][4]u8 = .{ .{ 255, 0, 0, 255 }, .{ 0, 255, 0, 255 }, .{ 0, 0, 255, 255 }, .{ 10, 20, 30, 40 } };
+    const image: WebImage(.ro, .@"rgba-unorm8") = .{ .data = &data, .width = 2, .height = 2 };
+    const Pixel = @Vector(4, f32);
+    const xs: @Vector(4, f32) = .{ 0.5, 1.0, 0.75, 1.5 };
+    const ys: @Vector(4, f32) = .{ 0.5, 1.0, 1.25, 0.5 };
+    const lanes = image.sampleLinearN(Pixel, 4, .{ xs, ys });
+    inline for (0..4) |i| {
+        const expected = image.sampleLinear(Pixel, .{ xs[i], ys[i] });
+        inline for (0..4) |c| try std.testing.expectApproxEqAbs(expected[c], lanes[c][i], 0.0001);
+    }
+}
@@ -4,24 +4,49 @@ const expectEqual = std.testing.expectEqual;
 const LinkedList = @import("linked-list.zig").LinkedList;
 
 pub fn Queue(comptime T: type) type {
+    return PriorityQueue(T, 1);
+}
+
+/// Queue with multiple lanes; items in lower-numbered lanes are pulled first
+pub fn PriorityQueue(comptime T: type, comptime lane_count: usize) type {
     return struct {
-        list: LinkedList(T),
+        lists: [lane_count]LinkedList(T),
         stopped: bool = false,
         item_futex: std.atomic.Value(u32) = std.atomic.Value(u32).init(0),
 
         pub fn init(allocator: std.mem.Allocator) @This() {
-            return .{ .list = .init(allocator) };
+            var self: @This() = .{ .lists = undefined };
+            for (&self.lists) |*list| list.* = .init(allocator);
+            return self;
         }
 
         pub fn push(self: *@This(), value: T) !void {
-            _ = try self.list.push(value);
+            return self.pushTo(value, 0);
+        }
+
+        pub fn pushTo(self: *@This(), value: T, lane: usize) !void {
+            _ = try self.lists[lane].push(value);
             self.item_futex.store(1, .release);
             std.Thread.Futex.wake(&self.item_futex, 1);
         }
 
         pub fn pull(self: *@This()) ?T {
-            if (self.list.shift()) |value| return value;
+            if (self.shift()) |value| return value;
             self.item_futex.store(0, .release);
+            if (lane_count > 1) {
+                // an item could have been added to a lane we've checked already
+                if (self.shift()) |value| {
+                    self.item_futex.store(1, .release);
+                    return value;
+                }
+            }
+            return null;
+        }
+
+        fn shift(self: *@This()) ?T {
+            for (&self.lists) |*list| {
+                if (list.shift()) |value| return value;
+            }
             return null;
         }
 
@@ -39,7 +64,7 @@ pub fn Queue(comptime T: type) type {
         }
 
         pub fn deinit(self: *@This()) void {
-            self.list.deinit();
+            for (&self.lists) |*list| list.deinit();
         }
     };
 }
@@ -60,3 +85,18 @@ test "Queue.pull()" {
     const value4 = queue.pull();
     try expectEqual(888, value4);
 }
+
+test "PriorityQueue.pull()" {
+    var gpa = std.heap.DebugAllocator(.{}).init;
+    var queue: PriorityQueue(i32, 3) = .init(gpa.allocator());
+    defer queue.deinit();
+    try queue.pushTo(123, 2);
+    try queue.pushTo(456, 1);
+    try queue.pushTo(789, 0);
+    try queue.pushTo(111, 1);
+    try expectEqual(789, queue.pull());
+    try expectEqual(456, queue.pull());
+    try expectEqual(111, queue.pull());
+    try expectEqual(123, queue.pull());
+    try expectEqual(null, queue.pull());
+}
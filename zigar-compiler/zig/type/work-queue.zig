@@ -7,13 +7,45 @@ const Generator = @import("generator.zig").Generator;
 const GeneratorOf = @import("generator.zig").GeneratorOf;
 const Promise = @import("promise.zig").Promise;
 const PromiseOf = @import("promise.zig").PromiseOf;
-const Queue = @import("queue.zig").Queue;
+const LinkedList = @import("linked-list.zig").LinkedList;
+const PriorityQueue = @import("queue.zig").PriorityQueue;
 const util = @import("util.zig");
+const WorkStealingQueue = @import("work-stealing-queue.zig").WorkStealingQueue;
+
+pub const Scheduling = enum {
+    /// all workers pull from a single queue
+    shared,
+    /// each worker has its own deque and steals from others when it runs out of work
+    work_stealing,
+};
+
+pub const Priority = enum(u2) {
+    high,
+    normal,
+    low,
+};
+
+pub const OverflowPolicy = enum {
+    /// accept the item and hold on to it until a worker frees up a slot; the caller never blocks
+    /// and the item's promise settles once it has been processed
+    wait,
+    /// fail with error.QueueFull
+    reject,
+};
 
 pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
     const decls = std.meta.declarations(ns);
     return struct {
-        queue: Queue(WorkItem) = undefined,
+        queue: Scheduler = undefined,
+        capacity: usize = 0,
+        overflow: OverflowPolicy = .wait,
+        item_count: std.atomic.Value(usize) = .init(0),
+        parked: LinkedList(Entry) = undefined,
+        parked_count: std.atomic.Value(usize) = .init(0),
+        parked_mutex: std.Thread.Mutex = .{},
+        parking_closed: bool = false,
+        rejected_count: std.atomic.Value(usize) = .init(0),
+        lane_stats: [priority_count]LaneCounters = undefined,
         thread_count: usize = 0,
         status: Status = .uninitialized,
         init_remaining: usize = undefined,
@@ -37,12 +69,16 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
             false => struct {},
             true => std.meta.ArgsTuple(@TypeOf(ns.onThreadEnd)),
         };
-        pub const Error = std.mem.Allocator.Error || error{Unexpected};
+        pub const Error = std.mem.Allocator.Error || error{ Unexpected, QueueFull };
         pub const Options = init: {
             const fields = std.meta.fields(struct {
                 allocator: std.mem.Allocator = def_allocator,
                 stack_size: usize = if (builtin.target.cpu.arch.isWasm()) 262144 else std.Thread.SpawnConfig.default_stack_size,
                 n_jobs: usize = 1,
+                scheduling: Scheduling = .shared,
+                // maximum number of items in the queue; 0 means no limit
+                capacity: usize = 0,
+                overflow: OverflowPolicy = .wait,
                 thread_start_params: ThreadStartParams,
                 thread_end_params: ThreadEndParams,
             });
@@ -67,13 +103,26 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
         pub const InitError = @typeInfo(InitResult).error_union.error_set;
 
         pub fn init(self: *@This(), options: Options) !void {
-            switch (self.status) {
+            switch (self.getStatus()) {
                 .uninitialized => {},
                 .initialized => return,
                 .deinitializing => return error.Deinitializing,
             }
             const allocator = options.allocator;
-            self.queue = .init(allocator);
+            self.queue = switch (options.scheduling) {
+                .shared => .{ .shared = .init(allocator) },
+                .work_stealing => .{ .work_stealing = try .init(allocator, options.n_jobs) },
+            };
+            errdefer if (self.thread_count == 0) self.queue.deinit();
+            self.capacity = options.capacity;
+            self.overflow = options.overflow;
+            self.item_count = .init(0);
+            self.parked = .init(allocator);
+            self.parked_count = .init(0);
+            self.parked_mutex = .{};
+            self.parking_closed = false;
+            self.rejected_count = .init(0);
+            for (&self.lane_stats) |*ls| ls.* = .{};
             self.init_remaining = options.n_jobs;
             self.init_futex = std.atomic.Value(u32).init(0);
             self.init_result = {};
@@ -100,16 +149,17 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
                 .stack_size = @max(min_stack_size, options.stack_size),
                 .allocator = allocator,
             };
-            for (0..options.n_jobs) |_| {
+            for (0..options.n_jobs) |index| {
                 const thread = try std.Thread.spawn(spawn_config, handleWorkItems, .{
                     self,
+                    index,
                     options.thread_start_params,
                     options.thread_end_params,
                 });
                 thread.detach();
                 self.thread_count += 1;
             }
-            self.status = .initialized;
+            self.setStatus(.initialized);
         }
 
         pub fn wait(self: *@This()) WaitResult {
@@ -126,7 +176,7 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
         }
 
         pub fn deinitAsync(self: *@This(), promise: ?Promise(void)) void {
-            switch (self.status) {
+            switch (self.getStatus()) {
                 .initialized => {},
                 else => {
                     if (promise) |p| p.resolve({});
@@ -134,19 +184,30 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
                 },
             }
             self.deinit_promise = promise;
-            self.status = .deinitializing;
+            self.setStatus(.deinitializing);
             self.queue.stop();
         }
 
         pub fn push(self: *@This(), comptime func: anytype, args: ArgsOf(func), dest: ?PromiseOrGenerator(func)) Error!void {
-            switch (self.status) {
+            return self.pushWithPriority(.normal, func, args, dest);
+        }
+
+        pub fn pushWithPriority(
+            self: *@This(),
+            priority: Priority,
+            comptime func: anytype,
+            args: ArgsOf(func),
+            dest: ?PromiseOrGenerator(func),
+        ) Error!void {
+            const status = self.getStatus();
+            switch (status) {
                 .initialized => {},
                 else => {
                     // see if we can do initialize automatically
                     const can_auto_init = check: {
                         if (std.meta.fields(ThreadStartParams).len > 0) break :check false;
                         if (std.meta.fields(ThreadEndParams).len > 0) break :check false;
-                        if (self.status != .uninitialized) break :check false;
+                        if (status != .uninitialized) break :check false;
                         break :check true;
                     };
                     if (can_auto_init) {
@@ -168,18 +229,141 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
                 true => @unionInit(WorkItem, fieldName, .{ .args = args, .generator = dest }),
                 false => @unionInit(WorkItem, fieldName, .{ .args = args, .promise = dest }),
             };
-            try self.queue.push(item);
+            const entry: Entry = .{ .item = item, .priority = priority, .queued_at = now() };
+            if (self.reserveSlot()) {
+                errdefer self.releaseSlot();
+                try self.queue.push(entry);
+            } else switch (self.overflow) {
+                .reject => {
+                    _ = self.rejected_count.fetchAdd(1, .monotonic);
+                    return error.QueueFull;
+                },
+                .wait => try self.park(entry),
+            }
         }
 
         pub fn clear(self: *@This()) void {
-            switch (self.status) {
+            switch (self.getStatus()) {
                 .initialized => {},
                 else => return,
             }
-            while (self.queue.pull() != null) {}
+            while (self.queue.pull() != null) self.releaseSlot();
+        }
+
+        pub const LaneStatistics = struct {
+            /// number of items taken from the lane by workers
+            count: usize,
+            /// total and maximum time items spent in the lane, in nanoseconds
+            total_wait: u64,
+            max_wait: u64,
+        };
+        pub const Statistics = struct {
+            /// number of items currently in the queue
+            depth: usize,
+            /// number of items waiting for space in the queue
+            waiting: usize,
+            /// number of items rejected because the queue was full
+            rejected: usize,
+            high: LaneStatistics,
+            normal: LaneStatistics,
+            low: LaneStatistics,
+        };
+
+        pub fn getStatistics(self: *@This()) Statistics {
+            var stats: Statistics = .{
+                .depth = self.item_count.load(.monotonic),
+                .waiting = self.parked_count.load(.monotonic),
+                .rejected = self.rejected_count.load(.monotonic),
+                .high = undefined,
+                .normal = undefined,
+                .low = undefined,
+            };
+            inline for (comptime std.enums.values(Priority)) |priority| {
+                const counters = &self.lane_stats[@intFromEnum(priority)];
+                @field(stats, @tagName(priority)) = .{
+                    .count = counters.count.load(.monotonic),
+                    .total_wait = counters.total_wait.load(.monotonic),
+                    .max_wait = counters.max_wait.load(.monotonic),
+                };
+            }
+            return stats;
+        }
+
+        fn reserveSlot(self: *@This()) bool {
+            if (self.capacity == 0) {
+                _ = self.item_count.fetchAdd(1, .monotonic);
+                return true;
+            }
+            var count = self.item_count.load(.monotonic);
+            while (count < self.capacity) {
+                count = self.item_count.cmpxchgWeak(count, count + 1, .acquire, .monotonic) orelse return true;
+            }
+            return false;
+        }
+
+        fn releaseSlot(self: *@This()) void {
+            _ = self.item_count.fetchSub(1, .release);
+            if (self.capacity != 0) self.admitParked();
+        }
+
+        fn park(self: *@This(), entry: Entry) Error!void {
+            {
+                self.parked_mutex.lock();
+                defer self.parked_mutex.unlock();
+                // no slot will free up once workers are gone
+                if (self.parking_closed) return error.Unexpected;
+                try self.parked.push(entry);
+                _ = self.parked_count.fetchAdd(1, .release);
+            }
+            // space might have become available in the meantime
+            self.admitParked();
+        }
+
+        fn unpark(self: *@This()) ?Entry {
+            self.parked_mutex.lock();
+            defer self.parked_mutex.unlock();
+            const entry = self.parked.shift() orelse return null;
+            _ = self.parked_count.fetchSub(1, .monotonic);
+            return entry;
+        }
+
+        fn admitParked(self: *@This()) void {
+            while (self.parked_count.load(.acquire) > 0) {
+                if (!self.reserveSlot()) break;
+                const entry = self.unpark() orelse {
+                    _ = self.item_count.fetchSub(1, .monotonic);
+                    break;
+                };
+                self.queue.push(entry) catch {
+                    // run the item here instead of leaving its promise hanging
+                    _ = self.item_count.fetchSub(1, .monotonic);
+                    invokeFunction(entry.item);
+                };
+            }
+        }
+
+        fn drainParked(self: *@This()) void {
+            self.parked_mutex.lock();
+            self.parking_closed = true;
+            self.parked_mutex.unlock();
+            // items accepted before shutdown still get to run, so that their promises settle
+            while (self.unpark()) |entry| invokeFunction(entry.item);
+            self.parked.deinit();
+        }
+
+        fn getStatus(self: *const @This()) Status {
+            return @atomicLoad(Status, &self.status, .acquire);
+        }
+
+        fn setStatus(self: *@This(), status: Status) void {
+            @atomicStore(Status, &self.status, status, .release);
         }
 
         pub fn asyncify(comptime self: *@This(), comptime func: anytype) Asyncified(@TypeOf(func)) {
+            return self.asyncifyWithPriority(func, .normal);
+        }
+
+        pub fn asyncifyWithPriority(comptime self: *@This(), comptime func: anytype, comptime priority: Priority) Asyncified(@TypeOf(func)) {
             const FT = @TypeOf(func);
             const Args = std.meta.ArgsTuple(FT);
             const AFT = Asyncified(FT);
@@ -192,7 +376,7 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
                     var args: Args = undefined;
                     inline for (&args, 0..) |*ptr, i| ptr.* = async_args[i];
                     const p_or_g = async_args[async_args.len - 1];
-                    return self.push(func, args, p_or_g);
+                    return self.pushWithPriority(priority, func, args, p_or_g);
                 }
             };
             return fn_transform.spreadArgs(async_ns.push, cc);
@@ -304,7 +488,7 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
             true => std.heap.wasm_allocator,
             false => std.heap.c_allocator,
         };
-        const Status = enum {
+        const Status = enum(u8) {
             uninitialized,
             initialized,
             deinitializing,
@@ -382,12 +566,87 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
                 Promise(RT);
         }
 
+        const priority_count = std.meta.fields(Priority).len;
+        const Entry = struct {
+            item: WorkItem,
+            priority: Priority,
+            queued_at: u64,
+        };
+        const LaneCounters = struct {
+            count: std.atomic.Value(usize) = .init(0),
+            total_wait: std.atomic.Value(u64) = .init(0),
+            max_wait: std.atomic.Value(u64) = .init(0),
+        };
+
+        fn now() u64 {
+            return std.math.lossyCast(u64, std.time.nanoTimestamp());
+        }
+
+        const Scheduler = union(Scheduling) {
+            shared: PriorityQueue(Entry, priority_count),
+            work_stealing: WorkStealingQueue(Entry, priority_count),
+
+            fn push(self: *@This(), entry: Entry) !void {
+                const lane = @intFromEnum(entry.priority);
+                switch (self.*) {
+                    inline else => |*q| try q.pushTo(entry, lane),
+                }
+            }
+
+            fn pull(self: *@This()) ?Entry {
+                return switch (self.*) {
+                    inline else => |*q| q.pull(),
+                };
+            }
+
+            fn wait(self: *@This()) void {
+                switch (self.*) {
+                    inline else => |*q| q.wait(),
+                }
+            }
+
+            fn stop(self: *@This()) void {
+                switch (self.*) {
+                    inline else => |*q| q.stop(),
+                }
+            }
+
+            fn isStopped(self: *const @This()) bool {
+                return switch (self.*) {
+                    inline else => |*q| q.stopped,
+                };
+            }
+
+            fn attachWorker(self: *@This(), index: usize) void {
+                switch (self.*) {
+                    .work_stealing => |*q| q.attachWorker(index),
+                    else => {},
+                }
+            }
+
+            fn detachWorker(self: *@This()) void {
+                switch (self.*) {
+                    .work_stealing => |*q| q.detachWorker(),
+                    else => {},
+                }
+            }
+
+            fn deinit(self: *@This()) void {
+                switch (self.*) {
+                    inline else => |*q| q.deinit(),
+                }
+            }
+        };
+
         fn handleWorkItems(
             self: *@This(),
+            index: usize,
             thread_start_params: ThreadStartParams,
             thread_end_params: ThreadEndParams,
         ) void {
             var start_succeeded = true;
+            self.queue.attachWorker(index);
+            defer self.queue.detachWorker();
             if (@hasDecl(ns, "onThreadStart")) {
                 const result = @call(.auto, ns.onThreadStart, thread_start_params);
                 if (ThreadStartError != error{}) {
@@ -408,9 +667,15 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
                 }
             }
             while (true) {
-                if (self.queue.pull()) |item| {
-                    invokeFunction(item);
-                } else switch (self.queue.stopped) {
+                if (self.queue.pull()) |entry| {
+                    const wait_time = now() -| entry.queued_at;
+                    const counters = &self.lane_stats[@intFromEnum(entry.priority)];
+                    _ = counters.count.fetchAdd(1, .monotonic);
+                    _ = counters.total_wait.fetchAdd(wait_time, .monotonic);
+                    _ = counters.max_wait.fetchMax(wait_time, .monotonic);
+                    self.releaseSlot();
+                    invokeFunction(entry.item);
+                } else switch (self.queue.isStopped()) {
                     false => self.queue.wait(),
                     true => break,
                 }
@@ -419,8 +684,9 @@ pub fn WorkQueue(comptime ns: type, comptime internal_ns: type) type {
                 if (start_succeeded) _ = @call(.auto, ns.onThreadEnd, thread_end_params);
             }
             if (@atomicRmw(usize, &self.thread_count, .Sub, 1, .monotonic) == 1) {
+                self.drainParked();
                 self.queue.deinit();
-                self.status = .uninitialized;
+                self.setStatus(.uninitialized);
                 if (@typeInfo(WaitResult) == .error_union and std.meta.isError(self.init_result)) {
                     self.init_futex.store(1, .release);
                     std.Thread.Futex.wake(&self.init_futex, std.math.maxInt(u32));
@@ -538,3 +804,115 @@ test "WorkQueue.promisify()" {
     try expectEqual(false, test_ns2.world_result);
     test_ns2.deinit();
 }
+
+test "WorkQueue (work stealing)" {
+    const test_ns = struct {
+        var total: std.atomic.Value(i32) = .init(0);
+
+        pub fn hello(num: i32) void {
+            _ = total.fetchAdd(num, .monotonic);
+        }
+
+        pub fn spawn(num: i32) void {
+            // items pushed from a worker go into its own deque
+            queue.push(hello, .{num}, null) catch {};
+            queue.push(hello, .{num}, null) catch {};
+        }
+
+        pub fn shutdown(futex: *std.atomic.Value(u32), _: void) void {
+            futex.store(1, .monotonic);
+            std.Thread.Futex.wake(futex, 1);
+        }
+
+        var queue: WorkQueue(@This(), struct {}) = .{};
+    };
+    var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+    const queue = &test_ns.queue;
+    try queue.init(.{ .allocator = gpa.allocator(), .n_jobs = 4, .scheduling = .work_stealing });
+    for (0..100) |_| try queue.push(test_ns.hello, .{1}, null);
+    for (0..100) |_| try queue.push(test_ns.spawn, .{10}, null);
+    std.time.sleep(2e+8);
+    try expectEqual(100 + 100 * 2 * 10, test_ns.total.load(.monotonic));
+    var futex: std.atomic.Value(u32) = .init(0);
+    queue.deinitAsync(.init(&futex, test_ns.shutdown));
+    // wait for thread shutdown
+    std.Thread.Futex.wait(&futex, 0);
+}
+
+test "WorkQueue (capacity)" {
+    const test_ns = struct {
+        var gate: std.atomic.Value(u32) = .init(0);
+        var order: [8]i32 = undefined;
+        var order_len: std.atomic.Value(usize) = .init(0);
+
+        pub fn block() void {
+            while (gate.load(.acquire) == 0) std.Thread.Futex.wait(&gate, 0);
+        }
+
+        pub fn record(num: i32) void {
+            order[order_len.fetchAdd(1, .monotonic)] = num;
+        }
+
+        pub fn shutdown(futex: *std.atomic.Value(u32), _: void) void {
+            futex.store(1, .monotonic);
+            std.Thread.Futex.wake(futex, 1);
+        }
+    };
+    const open_gate = struct {
+        fn call() void {
+            test_ns.gate.store(1, .release);
+            std.Thread.Futex.wake(&test_ns.gate, 1);
+        }
+    }.call;
+    var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+    {
+        var queue: WorkQueue(test_ns, struct {}) = .{};
+        try queue.init(.{ .allocator = gpa.allocator(), .n_jobs = 1, .capacity = 2, .overflow = .reject });
+        try queue.push(test_ns.block, .{}, null);
+        // wait for the worker to pick it up
+        std.time.sleep(5e+7);
+        try queue.push(test_ns.record, .{1}, null);
+        try queue.pushWithPriority(.high, test_ns.record, .{2}, null);
+        const result = queue.push(test_ns.record, .{3}, null);
+        try std.testing.expectError(error.QueueFull, result);
+        const stats1 = queue.getStatistics();
+        try expectEqual(2, stats1.depth);
+        try expectEqual(1, stats1.rejected);
+        open_gate();
+        std.time.sleep(5e+7);
+        // high-priority item should run first
+        try expectEqual(2, test_ns.order_len.load(.monotonic));
+        try expectEqual(2, test_ns.order[0]);
+        try expectEqual(1, test_ns.order[1]);
+        const stats2 = queue.getStatistics();
+        try expectEqual(0, stats2.depth);
+        try expectEqual(1, stats2.high.count);
+        try expectEqual(2, stats2.normal.count);
+        var futex: std.atomic.Value(u32) = .init(0);
+        queue.deinitAsync(.init(&futex, test_ns.shutdown));
+        std.Thread.Futex.wait(&futex, 0);
+    }
+    test_ns.gate.store(0, .monotonic);
+    test_ns.order_len.store(0, .monotonic);
+    {
+        var queue: WorkQueue(test_ns, struct {}) = .{};
+        try queue.init(.{ .allocator = gpa.allocator(), .n_jobs = 1, .capacity = 1, .overflow = .wait });
+        try queue.push(test_ns.block, .{}, null);
+        std.time.sleep(5e+7);
+        // pushes return right away; items beyond capacity wait for a slot
+        for (1..4) |num| try queue.push(test_ns.record, .{@as(i32, @intCast(num))}, null);
+        const stats1 = queue.getStatistics();
+        try expectEqual(1, stats1.depth);
+        try expectEqual(2, stats1.waiting);
+        try expectEqual(0, test_ns.order_len.load(.monotonic));
+        open_gate();
+        std.time.sleep(5e+7);
+        try expectEqual(3, test_ns.order_len.load(.monotonic));
+        try expectEqual(1, test_ns.order[0]);
+        try expectEqual(3, test_ns.order[2]);
+        try expectEqual(0, queue.getStatistics().waiting);
+        var futex: std.atomic.Value(u32) = .init(0);
+        queue.deinitAsync(.init(&futex, test_ns.shutdown));
+        std.Thread.Futex.wait(&futex, 0);
+    }
+}
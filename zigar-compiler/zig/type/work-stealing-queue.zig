@@ -0,0 +1,287 @@
+const std = @import("std");
+const expectEqual = std.testing.expectEqual;
+
+const LinkedList = @import("linked-list.zig").LinkedList;
+
+/// Queue where each worker thread has its own deque. Items pushed by a worker go into its own
+/// deque and are run in LIFO order; items pushed from other threads go into a shared injection
+/// list. Idle workers take from the injection list first, then steal from other workers. Items
+/// in lower-numbered lanes are always taken before those in higher-numbered ones.
+pub fn WorkStealingQueue(comptime T: type, comptime lane_count: usize) type {
+    return struct {
+        allocator: std.mem.Allocator,
+        // deques of worker n are found at [n * lane_count .. (n + 1) * lane_count]
+        deques: []Deque,
+        worker_count: usize,
+        injected: [lane_count]LinkedList(T),
+        pending: std.atomic.Value(usize) = .init(0),
+        signal: std.atomic.Value(u32) = .init(0),
+        idle_count: std.atomic.Value(usize) = .init(0),
+        stopped: bool = false,
+
+        threadlocal var current_owner: ?*const anyopaque = null;
+        threadlocal var current_index: usize = 0;
+        threadlocal var rng_state: u32 = 0;
+
+        // maximum number of items moved from the injection list to a worker's deque at once
+        const batch_size = 16;
+
+        const Deque = struct {
+            mutex: std.Thread.Mutex = .{},
+            buffer: []T = &.{},
+            head: usize = 0,
+            // only changed while the mutex is held, but read without it by popFront()
+            len: std.atomic.Value(usize) = .init(0),
+
+            fn pushBack(self: *@This(), allocator: std.mem.Allocator, value: T) !void {
+                self.mutex.lock();
+                defer self.mutex.unlock();
+                try self.ensureUnusedCapacity(allocator, 1);
+                const len = self.len.load(.monotonic);
+                self.buffer[(self.head + len) % self.buffer.len] = value;
+                self.len.store(len + 1, .monotonic);
+            }
+
+            fn pushBackFrom(self: *@This(), allocator: std.mem.Allocator, list: *LinkedList(T), max: usize) void {
+                self.mutex.lock();
+                defer self.mutex.unlock();
+                self.ensureUnusedCapacity(allocator, max) catch return;
+                var len = self.len.load(.monotonic);
+                defer self.len.store(len, .monotonic);
+                for (0..max) |_| {
+                    const value = list.shift() orelse break;
+                    self.buffer[(self.head + len) % self.buffer.len] = value;
+                    len += 1;
+                }
+            }
+
+            fn ensureUnusedCapacity(self: *@This(), allocator: std.mem.Allocator, count: usize) !void {
+                const len = self.len.load(.monotonic);
+                if (len + count <= self.buffer.len) return;
+                const new_len = @max(16, self.buffer.len * 2, len + count);
+                const new_buffer = try allocator.alloc(T, new_len);
+                for (0..len) |i| {
+                    new_buffer[i] = self.buffer[(self.head + i) % self.buffer.len];
+                }
+                allocator.free(self.buffer);
+                self.buffer = new_buffer;
+                self.head = 0;
+            }
+
+            fn popBack(self: *@This()) ?T {
+                self.mutex.lock();
+                defer self.mutex.unlock();
+                const len = self.len.load(.monotonic);
+                if (len == 0) return null;
+                self.len.store(len - 1, .monotonic);
+                return self.buffer[(self.head + len - 1) % self.buffer.len];
+            }
+
+            fn popFront(self: *@This()) ?T {
+                // don't bother contending for the lock when there's nothing there
+                if (self.len.load(.monotonic) == 0) return null;
+                self.mutex.lock();
+                defer self.mutex.unlock();
+                const len = self.len.load(.monotonic);
+                if (len == 0) return null;
+                const value = self.buffer[self.head];
+                self.head = (self.head + 1) % self.buffer.len;
+                self.len.store(len - 1, .monotonic);
+                return value;
+            }
+
+            fn deinit(self: *@This(), allocator: std.mem.Allocator) void {
+                allocator.free(self.buffer);
+                self.* = .{};
+            }
+        };
+
+        pub fn init(allocator: std.mem.Allocator, worker_count: usize) !@This() {
+            const count = @max(1, worker_count);
+            const deques = try allocator.alloc(Deque, count * lane_count);
+            for (deques) |*deque| deque.* = .{};
+            var self: @This() = .{
+                .allocator = allocator,
+                .deques = deques,
+                .worker_count = count,
+                .injected = undefined,
+            };
+            for (&self.injected) |*list| list.* = .init(allocator);
+            return self;
+        }
+
+        /// Associate the calling thread with one of the deques
+        pub fn attachWorker(self: *@This(), index: usize) void {
+            current_owner = self;
+            current_index = index % self.worker_count;
+            rng_state = @truncate(index *% 2654435761 +% 1);
+        }
+
+        pub fn detachWorker(_: *@This()) void {
+            current_owner = null;
+        }
+
+        pub fn push(self: *@This(), value: T) !void {
+            return self.pushTo(value, 0);
+        }
+
+        pub fn pushTo(self: *@This(), value: T, lane: usize) !void {
+            if (self.getWorkerIndex()) |index| {
+                try self.getDeque(index, lane).pushBack(self.allocator, value);
+            } else {
+                try self.injected[lane].push(value);
+            }
+            _ = self.pending.fetchAdd(1, .seq_cst);
+            _ = self.signal.fetchAdd(1, .seq_cst);
+            if (self.idle_count.load(.seq_cst) > 0) {
+                std.Thread.Futex.wake(&self.signal, 1);
+            }
+        }
+
+        pub fn pull(self: *@This()) ?T {
+            if (self.pending.load(.acquire) == 0) return null;
+            const index_maybe = self.getWorkerIndex();
+            const start = self.random() % self.worker_count;
+            for (0..lane_count) |lane| {
+                if (index_maybe) |index| {
+                    if (self.getDeque(index, lane).popBack()) |value| return self.take(value);
+                }
+                if (self.injected[lane].shift()) |value| {
+                    if (index_maybe) |index| {
+                        // move a batch into our deque, so other idle workers would have something to
+                        // steal instead of all hammering the injection list
+                        self.getDeque(index, lane).pushBackFrom(self.allocator, &self.injected[lane], batch_size - 1);
+                    }
+                    return self.take(value);
+                }
+                // steal from a random victim
+                for (0..self.worker_count) |i| {
+                    const victim = (start + i) % self.worker_count;
+                    if (index_maybe == victim) continue;
+                    if (self.getDeque(victim, lane).popFront()) |value| return self.take(value);
+                }
+            }
+            return null;
+        }
+
+        pub fn wait(self: *@This()) void {
+            const seen = self.signal.load(.seq_cst);
+            _ = self.idle_count.fetchAdd(1, .seq_cst);
+            defer _ = self.idle_count.fetchSub(1, .seq_cst);
+            // check again now that pushers can see that we're idle
+            if (self.pending.load(.seq_cst) > 0 or self.stopped) return;
+            std.Thread.Futex.wait(&self.signal, seen);
+        }
+
+        pub fn stop(self: *@This()) void {
+            if (self.stopped) return;
+            self.stopped = true;
+            while (self.pull()) |_| {}
+            // wake up awaking threads and prevent them from sleep again
+            _ = self.signal.fetchAdd(1, .seq_cst);
+            std.Thread.Futex.wake(&self.signal, std.math.maxInt(u32));
+        }
+
+        pub fn deinit(self: *@This()) void {
+            for (self.deques) |*deque| deque.deinit(self.allocator);
+            self.allocator.free(self.deques);
+            for (&self.injected) |*list| list.deinit();
+        }
+
+        fn take(self: *@This(), value: T) T {
+            _ = self.pending.fetchSub(1, .monotonic);
+            return value;
+        }
+
+        fn getDeque(self: *@This(), index: usize, lane: usize) *Deque {
+            return &self.deques[index * lane_count + lane];
+        }
+
+        fn getWorkerIndex(self: *const @This()) ?usize {
+            return if (current_owner == @as(*const anyopaque, self)) current_index else null;
+        }
+
+        fn random(_: *const @This()) usize {
+            // xorshift32
+            var x = rng_state;
+            if (x == 0) x = 0x9e3779b9;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            rng_state = x;
+            return x;
+        }
+    };
+}
+
+test "WorkStealingQueue.pull()" {
+    var gpa = std.heap.DebugAllocator(.{}).init;
+    var queue: WorkStealingQueue(i32, 1) = try .init(gpa.allocator(), 2);
+    defer queue.deinit();
+    try queue.push(123);
+    try queue.push(456);
+    const value1 = queue.pull();
+    try expectEqual(123, value1);
+    const value2 = queue.pull();
+    try expectEqual(456, value2);
+    const value3 = queue.pull();
+    try expectEqual(null, value3);
+}
+
+test "WorkStealingQueue.pull() (LIFO for worker)" {
+    var gpa = std.heap.DebugAllocator(.{}).init;
+    var queue: WorkStealingQueue(i32, 1) = try .init(gpa.allocator(), 2);
+    defer queue.deinit();
+    queue.attachWorker(0);
+    defer queue.detachWorker();
+    try queue.push(123);
+    try queue.push(456);
+    const value1 = queue.pull();
+    try expectEqual(456, value1);
+    const value2 = queue.pull();
+    try expectEqual(123, value2);
+    const value3 = queue.pull();
+    try expectEqual(null, value3);
+}
+
+test "WorkStealingQueue.pull() (stealing)" {
+    var gpa = std.heap.DebugAllocator(.{}).init;
+    var queue: WorkStealingQueue(i32, 1) = try .init(gpa.allocator(), 2);
+    defer queue.deinit();
+    try queue.deques[1].pushBack(gpa.allocator(), 123);
+    try queue.deques[1].pushBack(gpa.allocator(), 456);
+    queue.pending.store(2, .monotonic);
+    queue.attachWorker(0);
+    defer queue.detachWorker();
+    // should take from the front of the other worker's deque
+    const value1 = queue.pull();
+    try expectEqual(123, value1);
+    const value2 = queue.pull();
+    try expectEqual(456, value2);
+    const value3 = queue.pull();
+    try expectEqual(null, value3);
+}
+
+test "WorkStealingQueue.stop()" {
+    var gpa = std.heap.DebugAllocator(.{}).init;
+    var queue: WorkStealingQueue(i32, 1) = try .init(gpa.allocator(), 2);
+    defer queue.deinit();
+    try queue.push(123);
+    queue.stop();
+    try expectEqual(null, queue.pull());
+    // should return immediately
+    queue.wait();
+}
+
+test "WorkStealingQueue.pull() (lanes)" {
+    var gpa = std.heap.DebugAllocator(.{}).init;
+    var queue: WorkStealingQueue(i32, 3) = try .init(gpa.allocator(), 2);
+    defer queue.deinit();
+    try queue.pushTo(123, 2);
+    try queue.pushTo(456, 1);
+    try queue.pushTo(789, 0);
+    try expectEqual(789, queue.pull());
+    try expectEqual(456, queue.pull());
+    try expectEqual(123, queue.pull());
+    try expectEqual(null, queue.pull());
+}
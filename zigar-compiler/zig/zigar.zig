@@ -19,6 +19,10 @@ pub const thread = struct {
 
 pub const io = struct {
     pub const redirect = host.redirectIO;
+    pub const getOutputStats = host.getOutputStats;
+    pub const flush = host.flushOutput;
+
+    pub const OutputStats = host.OutputStats;
 };
 
 pub const image = struct {
@@ -26,6 +30,7 @@ pub const image = struct {
 
     pub const Access = host.image.Access;
     pub const Format = host.image.Format;
+    pub const Lanes = host.image.Lanes;
 
     pub const Any = host.image.AnyImage;
     pub const Gd = host.image.GdImage;
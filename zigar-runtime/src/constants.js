@@ -139,6 +139,25 @@ export const VisitorFlag = {
   IgnoreArguments: 1 << 4,
   IgnoreRetval: 1 << 5,
 };
+export const MetadataTag = {
+  Undefined: 0,
+  Null: 1,
+  False: 2,
+  True: 3,
+  Uint: 4,
+  NegativeInt: 5,
+  Float: 6,
+  String: 7,
+  BigInt: 8,
+  Array: 9,
+  Record: 10,
+  StructureRef: 11,
+  ObjectRef: 12,
+  BufferRef: 13,
+  NegativeBigInt: 14,
+};
+// "zmd" followed by format version
+export const metadataMagic = [ 0x7a, 0x6d, 0x64, 1 ];
 export const PosixError = { // values mirror std.os.wasi.errno_t
   NONE: 0,  
   EACCES: 2,
@@ -2,6 +2,7 @@ import { structureNames } from '../constants.js';
 import { mixin } from '../environment.js';
 import { TypeMismatch } from '../errors.js';
 import { ALIGN, ENVIRONMENT, MEMORY, SIZE, SLOTS, TYPE } from '../symbols.js';
+import { defineProperty } from '../utils.js';
 
 const events = [ 
   'log', 'mkdir', 'stat', 'utimes', 'open', 'rename', 'readlink', 'rmdir', 'symlink', 'unlink'
@@ -11,6 +12,7 @@ const firstMasked = 1;
 export default mixin({
   init() {
     this.variables = [];
+    this.variableLinkage = null;
     this.listenerMap = new Map();
     this.envVariables = this.envVarArrays = null;
   },
@@ -19,6 +21,11 @@ export default mixin({
       if (v === undefined) throw new Error('Not a Zig type');
       return v;
     };
+    const metrics = () => {
+      // the feature is left out of transpiled code unless the metrics option is set
+      if (!this.enableMetrics) throw new Error('Metrics not available');
+      return this;
+    };
     return {
       init: () => this.initPromise,
       abandon: () => this.abandonModule?.(),
@@ -28,6 +35,9 @@ export default mixin({
       typeOf: (T) => structureNamesLC[check(T?.[TYPE])],
       on: (name, cb) => this.addListener(name, cb),
       set: (name, value) => this.setObject(name, value),
+      startMetrics: (options) => metrics().enableMetrics(options),
+      stopMetrics: () => metrics().disableMetrics(),
+      getMetrics: (reset) => metrics().getMetrics(reset),
     };
   },
   addListener(name, cb) {
@@ -68,7 +78,7 @@ export default mixin({
     const listener = this.listenerMap.get(name);
     return listener?.(event);
   },
-  recreateStructures(structures, settings) {
+  recreateStructures(structures, settings, lazy = false) {
     Object.assign(this, settings);
     const insertObjects = (dest, placeholders) => {
       for (const [ slot, placeholder ] of Object.entries(placeholders)) {
@@ -77,6 +87,7 @@ export default mixin({
       return dest;
     };
     const readOnlyObjects = [];
+    const newVariables = [];
     // empty arrays aren't replicated
     const getBuffer = a => (a.length) ? a.buffer : new ArrayBuffer(0);
     const createObject = (placeholder) => {
@@ -96,7 +107,7 @@ export default mixin({
           if (handle !== undefined) {
             // need to replace dataview with one pointing to Zig memory later,
             // when the VM is up and running
-            this.variables.push({ handle, object });
+            newVariables.push({ object, handle });
           } else if (offset === undefined) {
             // save the object for later, since it constructor isn't isn't finalized yet
             // when offset is not undefined, the object is a child of another object and 
@@ -111,7 +122,7 @@ export default mixin({
       }
     };
     const objectPlaceholders = new Map();
-    for (const structure of structures) {
+    const prepareTemplates = (structure) => {
       // recreate the actual template using the provided placeholder
       for (const scope of [ structure.instance, structure.static ]) {
         if (scope.template) {
@@ -121,7 +132,7 @@ export default mixin({
             const { array, offset, length } = memory;
             object[MEMORY] = this.obtainView(getBuffer(array), offset, length);
             if (handle !== undefined) {
-              this.variables.push({ handle, object });
+              newVariables.push({ object, handle });
             }
           }
           if (slots) {
@@ -131,20 +142,97 @@ export default mixin({
           }
         }
       }
-      this.defineStructure(structure);
-    }
-    // insert objects into template slots
-    for (const [ slots, placeholders ] of objectPlaceholders) {
-      insertObjects(slots, placeholders);
-    }
-    // add static members, methods, etc.
-    for (const structure of structures) {
-      this.finalizeStructure(structure);
+    };
+    const insertTemplateObjects = () => {
+      for (const [ slots, placeholders ] of objectPlaceholders) {
+        objectPlaceholders.delete(slots);
+        insertObjects(slots, placeholders);
+      }
+    };
+    const completeObjects = () => {
+      // after finalization, constructors of objects will have the properties needed 
+      // for proper detection of what they are
+      for (const object of readOnlyObjects.splice(0)) {
+        this.makeReadOnly(object);
+      }
+      for (const { object, handle } of newVariables.splice(0)) {
+        this.addVariable(object, handle);
+      }
+    };
+    if (lazy) {
+      // define a structure only when its constructor is first accessed
+      const thisEnv = this;
+      let depth = 0;
+      const pending = [];
+      for (const structure of structures) {
+        let defining = false;
+        defineProperty(structure, 'constructor', {
+          get() {
+            if (defining) {
+              // constructor is being created
+              return null;
+            }
+            defining = true;
+            depth++;
+            let succeeded = false;
+            try {
+              prepareTemplates(structure);
+              thisEnv.defineStructure(structure);
+              pending.push(structure);
+              if (depth === 1) {
+                // finalize only after every structure reached from this one has been defined,
+                // since a self-referential type would otherwise see null as its own constructor
+                for (let i = 0; i < pending.length; i++) {
+                  insertTemplateObjects();
+                  thisEnv.finalizeStructure(pending[i]);
+                }
+                pending.splice(0);
+                completeObjects();
+              }
+              succeeded = true;
+            } finally {
+              depth--;
+              if (!succeeded) {
+                // allow another attempt on next access
+                defining = false;
+                if (depth === 0) {
+                  pending.splice(0);
+                }
+              }
+            }
+            return structure.constructor;
+          },
+          set(constructor) {
+            defineProperty(structure, 'constructor', {
+              value: constructor,
+              writable: true,
+              enumerable: true,
+              configurable: true,
+            });
+          },
+          enumerable: true,
+          configurable: true,
+        });
+      }
+    } else {
+      for (const structure of structures) {
+        prepareTemplates(structure);
+        this.defineStructure(structure);
+      }
+      // insert objects into template slots
+      insertTemplateObjects();
+      // add static members, methods, etc.
+      for (const structure of structures) {
+        this.finalizeStructure(structure);
+      }
+      completeObjects();
     }
-    // after finalization, constructors of objects will have the properties needed 
-    // for proper detection of what they are
-    for (const object of readOnlyObjects) {
-      this.makeReadOnly(object);
+  },
+  addVariable(object, handle) {
+    this.variables.push({ handle, object });
+    if (this.variableLinkage) {
+      // object was created after linkage had occurred (structure was defined lazily)
+      this.linkVariable(object, handle, this.variableLinkage.writeBack);
     }
   },
   ...(process.env.TARGET === 'wasm' ? {
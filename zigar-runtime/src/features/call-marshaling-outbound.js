@@ -1,15 +1,22 @@
-import { MemberType, StructurePurpose, StructureType } from '../constants.js';
+import {
+  ArgStructFlag, MemberType, StructureFlag, StructurePurpose, StructureType,
+} from '../constants.js';
 import { mixin } from '../environment.js';
-import { adjustArgumentError, Exit, UndefinedArgument, ZigError } from '../errors.js';
 import {
-  ALLOCATOR, ATTRIBUTES,
-  FINALIZE, GENERATOR, MEMORY, PROMISE, RETURN, SETTERS, TRANSFORM,
+  adjustArgumentError, ArgumentCountMismatch, Exit, UndefinedArgument, ZigError,
+} from '../errors.js';
+import {
+  ALIGN, ALLOCATOR, ATTRIBUTES,
+  FINALIZE, GENERATOR, MEMORY, PROMISE, RETURN, SETTERS, SIZE, TRANSFORM,
   UPDATE,
   VISIT
 } from '../symbols.js';
 
 export default mixin({
-  createOutboundCaller(thunk, ArgStruct) {
+  createOutboundCaller(thunk, ArgStruct, structure) {
+    if (structure && isScalarOnly(structure)) {
+      return this.createScalarCaller(thunk, ArgStruct);
+    }
     const thisEnv = this;
     const self = function (...args) {
       if (process.env.DEV) {
@@ -41,6 +48,105 @@ export default mixin({
     };
     return self;
   },
+  createScalarCaller(thunk, ArgStruct) {
+    // functions that only deal with numbers and booleans don't need shadows or pointer updates;
+    // we can use the same argument struct over and over again
+    const thisEnv = this;
+    const argCount = ArgStruct.prototype.length;
+    let argStruct, setters, thunkAddress, fnAddress, argAddress;
+    let busy = false;
+    const invoke = (args) => {
+      if (busy) {
+        // the function is being called again by a callback
+        return thisEnv.invokeThunk(thunk, self, new ArgStruct(args));
+      }
+      if (args.length !== argCount) {
+        throw new ArgumentCountMismatch(argCount, args.length);
+      }
+      if (!argStruct) {
+        // on WebAssembly the struct is placed directly in Zig memory, since there's no shadow
+        const dv = (process.env.TARGET === 'wasm')
+        ? thisEnv.allocateShadowMemory(ArgStruct[SIZE], ArgStruct[ALIGN])
+        : thisEnv.allocateMemory(ArgStruct[SIZE], ArgStruct[ALIGN]);
+        argStruct = ArgStruct(dv);
+        setters = argStruct[SETTERS];
+        thunkAddress = thisEnv.getViewAddress(thunk[MEMORY]);
+        fnAddress = thisEnv.getViewAddress(self[MEMORY]);
+        argAddress = thisEnv.getViewAddress(dv);
+      } else if (process.env.TARGET === 'wasm') {
+        // memory might have grown since the last call
+        argStruct[MEMORY] = thisEnv.restoreView(argStruct[MEMORY]);
+      }
+      for (let i = 0; i < argCount; i++) {
+        const arg = args[i];
+        if (arg === undefined) {
+          throw new UndefinedArgument();
+        }
+        try {
+          setters[i].call(argStruct, arg);
+        } catch (err) {
+          throw adjustArgumentError(err, i);
+        }
+      }
+      /* c8 ignore start */
+      if (process.env.MIXIN === 'track') {
+        thisEnv.trackingMixins = true;
+      }
+      /* c8 ignore end */
+      busy = true;
+      const { metrics } = thisEnv;
+      const start = (metrics) ? performance.now() : 0;
+      let success;
+      try {
+        success = thisEnv.runThunk(thunkAddress, fnAddress, argAddress);
+      } finally {
+        busy = false;
+        if (metrics) {
+          thisEnv.recordCall(self, start, null);
+        }
+        // output without a trailing newline shouldn't have to wait for the timer
+        thisEnv.flushStreams?.();
+      }
+      if (!success) {
+        throw new ZigError();
+      }
+      if (process.env.TARGET === 'wasm') {
+        argStruct[MEMORY] = thisEnv.restoreView(argStruct[MEMORY]);
+      }
+      const transform = self[TRANSFORM];
+      try {
+        const { retval } = argStruct;
+        return (transform) ? transform(retval) : retval;
+      } catch (err) {
+        throw new ZigError(err, 1);
+      }
+    };
+    const self = function (...args) {
+      if (process.env.DEV) {
+        thisEnv.outboundCallCount++;
+        thisEnv.scalarCallCount++;
+      }
+      if (process.env.TARGET === 'wasm') {
+        if (!thisEnv.runThunk) {
+          return thisEnv.initPromise.then(() => {
+            return self(...args);
+          });
+        }
+        try {
+          return invoke(args);
+        } catch (err) {
+          // do nothing when exit code is 0
+          if (err instanceof Exit && err.code === 0) {
+            return;
+          }
+          throw err;
+        }
+      } else {
+        return invoke(args);
+      }
+    };
+    return self;
+  },
   copyArguments(argStruct, argList, members, options, argAlloc) {
     let destIndex = 0, srcIndex = 0;
     let allocatorCount = 0;
@@ -97,6 +203,8 @@ export default mixin({
     }
   },
   invokeThunk(thunk, fn, argStruct) {
+    const { metrics } = this;
+    const start = (metrics) ? performance.now() : 0;
     const context = this.startContext();
     const attrs = argStruct[ATTRIBUTES];
     const thunkAddress = this.getViewAddress(thunk[MEMORY]);
@@ -125,6 +233,10 @@ export default mixin({
       this.flushStreams?.();
       this.endContext();
       finalized = true;
+      if (metrics) {
+        // time of async call includes the time it takes for the promise to get resolved
+        this.recordCall(fn, start, context);
+      }
     };
     if (isAsync) {
       argStruct[FINALIZE] = finalize;
@@ -199,12 +311,45 @@ export default mixin({
   /* c8 ignore start */
   ...(process.env.DEV ? {
     outboundCallCount: 0,
+    scalarCallCount: 0,
 
     diagCallMarshallingOutbound() {
       this.showDiagnostics('Outbound call marshalling', [
         `Call count: ${this.outboundCallCount}`,
+        `Scalar-only call count: ${this.scalarCallCount}`,
       ]);
     }
   } : undefined),
   /* c8 ignore end */
 });
+
+function isScalarOnly(structure) {
+  const { type, flags, instance: { members } } = structure;
+  if (type !== StructureType.ArgStruct) {
+    return false;
+  }
+  const excluded = StructureFlag.HasObject | StructureFlag.HasPointer | StructureFlag.HasSlot
+                 | ArgStructFlag.HasOptions | ArgStructFlag.IsAsync;
+  if (flags & excluded) {
+    return false;
+  }
+  // allocators, promises, generators, signals and files are all structs
+  for (const member of members) {
+    switch (member.type) {
+      case MemberType.Bool:
+      case MemberType.Int:
+      case MemberType.Uint:
+      case MemberType.Float:
+        break;
+      case MemberType.Void:
+        // only a void return value is acceptable; a void argument would need special handling
+        if (member !== members[0]) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
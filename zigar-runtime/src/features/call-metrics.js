@@ -0,0 +1,132 @@
+import { mixin } from '../environment.js';
+
+// upper bounds of latency buckets, in microseconds; calls taking longer go into the last bucket
+const latencyBuckets = [ 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000 ];
+
+export default mixin({
+  init() {
+    // metrics are only gathered when enabled, since timing every call is not free
+    this.metrics = null;
+    this.metricsTimer = 0;
+  },
+  enableMetrics(options = {}) {
+    const { interval = 0, reset = true, onReport } = options;
+    if (interval > 0 && typeof(onReport) !== 'function') {
+      throw new TypeError('onReport must be a function when interval is given');
+    }
+    this.disableMetrics();
+    this.metrics = createMetrics();
+    if (interval > 0) {
+      const timer = this.metricsTimer = setInterval(() => onReport(this.getMetrics(reset)), interval);
+      // don't keep Node.js alive for the sake of reporting
+      timer.unref?.();
+    }
+  },
+  disableMetrics() {
+    if (this.metricsTimer) {
+      clearInterval(this.metricsTimer);
+      this.metricsTimer = 0;
+    }
+    this.metrics = null;
+  },
+  getMetrics(reset = false) {
+    const { metrics } = this;
+    if (!metrics) {
+      return null;
+    }
+    const end = performance.now();
+    const functions = [];
+    for (const [ fn, entry ] of metrics.functions) {
+      const { count, totalTime, maxTime, bytesCopied, histogram } = entry;
+      functions.push({
+        name: fn.name,
+        count,
+        totalTime,
+        maxTime,
+        bytesCopied,
+        histogram: [ ...histogram ],
+      });
+    }
+    // hottest function first
+    functions.sort((a, b) => b.totalTime - a.totalTime);
+    const snapshot = {
+      duration: end - metrics.start,
+      latencyBuckets: [ ...latencyBuckets, Infinity ],
+      functions,
+      shadowCopy: {
+        bytesIn: metrics.shadowBytesIn,
+        bytesOut: metrics.shadowBytesOut,
+      },
+      crossThread: {
+        callbacks: metrics.crossThreadCallbacks,
+        syscalls: metrics.crossThreadSyscalls,
+      },
+    };
+    if (reset) {
+      this.metrics = createMetrics(end);
+    }
+    return snapshot;
+  },
+  recordCall(fn, start, context) {
+    const { metrics } = this;
+    if (!metrics) {
+      // metrics were disabled while the call was in progress
+      return;
+    }
+    const elapsed = performance.now() - start;
+    let entry = metrics.functions.get(fn);
+    if (!entry) {
+      entry = {
+        count: 0,
+        totalTime: 0,
+        maxTime: 0,
+        bytesCopied: 0,
+        histogram: new Uint32Array(latencyBuckets.length + 1),
+      };
+      metrics.functions.set(fn, entry);
+    }
+    entry.count++;
+    entry.totalTime += elapsed;
+    if (elapsed > entry.maxTime) {
+      entry.maxTime = elapsed;
+    }
+    if (context) {
+      entry.bytesCopied += context.bytesCopied ?? 0;
+    }
+    const us = elapsed * 1000;
+    let index = 0;
+    while (index < latencyBuckets.length && us > latencyBuckets[index]) {
+      index++;
+    }
+    entry.histogram[index]++;
+  },
+  recordShadowCopy(context, bytes, inbound) {
+    const { metrics } = this;
+    if (inbound) {
+      metrics.shadowBytesIn += bytes;
+    } else {
+      metrics.shadowBytesOut += bytes;
+    }
+    context.bytesCopied = (context.bytesCopied ?? 0) + bytes;
+  },
+  recordThreadCrossing(name) {
+    const { metrics } = this;
+    // everything other than a JavaScript function call is a syscall redirected to the main thread
+    if (name === 'handleJscall' || name === '_handleJscall') {
+      metrics.crossThreadCallbacks++;
+    } else {
+      metrics.crossThreadSyscalls++;
+    }
+  },
+});
+
+function createMetrics(start = performance.now()) {
+  return {
+    start,
+    functions: new Map(),
+    shadowBytesIn: 0,
+    shadowBytesOut: 0,
+    crossThreadCallbacks: 0,
+    crossThreadSyscalls: 0,
+  };
+}
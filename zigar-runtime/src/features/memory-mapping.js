@@ -13,14 +13,17 @@ export default mixin({
     this.contextCount = 0;
     if (process.env.TARGET === 'node') {
       this.externBufferList = [];
+    } else if (process.env.TARGET === 'wasm') {
+      this.shadowArenas = [];
     }
     if (process.env.DEV) {
       this.shadowMemoryBytes = 0;
+      this.shadowArenaCount = 0;
     }
   },
   startContext() {
     ++this.contextCount;
-    return { shadowList: [] };
+    return { shadowList: [], arena: null };
   },
   endContext() {
     if (--this.contextCount === 0) {
@@ -30,6 +33,12 @@ export default mixin({
         }
       }
       this.memoryList.splice(0);
+      if (process.env.TARGET === 'wasm') {
+        for (const arenaDV of this.shadowArenas) {
+          this.freeShadowMemory(arenaDV);
+        }
+        this.shadowArenas.splice(0);
+      }
     }
   },
   getShadowAddress(context, target, cluster, writable) {
@@ -50,7 +59,7 @@ export default mixin({
         }
         // ensure the shadow buffer is large enough to accommodate necessary adjustments
         const len = end - start;
-        const unalignedDV = this.allocateShadowMemory(len + maxAlign, 1);
+        const unalignedDV = this.allocateContextMemory(context, len + maxAlign, 1);
         const unalignedAddress = this.getViewAddress(unalignedDV);
         const maxAlignAddress = alignForward(adjustAddress(unalignedAddress, maxAlignOffset - start), maxAlign);
         const address = adjustAddress(maxAlignAddress, start - maxAlignOffset);
@@ -69,7 +78,8 @@ export default mixin({
         const shadowDV = new DataView(unalignedDV.buffer, shadowOffset, len);
         if (process.env.TARGET === 'wasm') {
           // attach Zig memory info to aligned data view so it gets freed correctly
-          shadowDV[ZIG] = { address, len, align: 1, unalignedAddress, type: MemoryType.Scratch };
+          const type = unalignedDV[ZIG].type ?? MemoryType.Scratch;
+          shadowDV[ZIG] = { address, len, align: 1, unalignedAddress, type };
         }
         const clusterDV = new DataView(targetDV.buffer, Number(start), len);
         const entry = this.registerMemory(address, len, 1, writable, clusterDV, shadowDV);
@@ -80,7 +90,7 @@ export default mixin({
     } else {
       const align = target.constructor[ALIGN] ?? targetDV[ALIGN];
       const len = targetDV.byteLength;
-      const shadowDV = this.allocateShadowMemory(len, align);
+      const shadowDV = this.allocateContextMemory(context, len, align);
       const address = this.getViewAddress(shadowDV)
       const entry = this.registerMemory(address, len, 1, writable, targetDV, shadowDV);
       context.shadowList.push(entry);
@@ -88,22 +98,32 @@ export default mixin({
     }
   },
   updateShadows(context) {
+    let bytes = 0;
     for (let { targetDV, shadowDV } of context.shadowList) {
       if (process.env.TARGET === 'wasm') {
         shadowDV = this.restoreView(shadowDV);
       }
       copyView(shadowDV, targetDV);
+      bytes += targetDV.byteLength;
+    }
+    if (this.metrics) {
+      this.recordShadowCopy(context, bytes, true);
     }
   },
   updateShadowTargets(context) {
+    let bytes = 0;
     for (let { targetDV, shadowDV, writable } of context.shadowList) {
       if (writable) {
         if (process.env.TARGET === 'wasm') {
           shadowDV = this.restoreView(shadowDV);
         }
         copyView(targetDV, shadowDV);
+        bytes += targetDV.byteLength;
       }
     }
+    if (this.metrics) {
+      this.recordShadowCopy(context, bytes, false);
+    }
   },
   registerMemory(address, len, align, writable, targetDV, shadowDV) {
     const index = findMemoryIndex(this.memoryList, address, len);
@@ -213,8 +233,39 @@ export default mixin({
       }
       return dv;
     },
+    reserveShadowMemory(context, len) {
+      // shadows needed by a call are carved from one block so we don't have to go into Zig
+      // to allocate and free each of them
+      if (len > 0 && !context.arena) {
+        const arenaDV = this.allocateShadowMemory(len, 16);
+        this.shadowArenas.push(arenaDV);
+        context.arena = { dv: arenaDV, address: this.getViewAddress(arenaDV), used: 0, len };
+        if (process.env.DEV) {
+          this.shadowArenaCount++;
+        }
+      }
+    },
+    allocateContextMemory(context, len, align) {
+      const { arena } = context;
+      if (arena && len > 0) {
+        const address = alignForward(adjustAddress(arena.address, arena.used), align || 1);
+        const used = Number(address - arena.address) + len;
+        if (used <= arena.len) {
+          arena.used = used;
+          const arenaDV = this.restoreView(arena.dv);
+          const dv = new DataView(arenaDV.buffer, arenaDV.byteOffset + used - len, len);
+          dv[ZIG] = { address, len, align, type: MemoryType.Arena };
+          return dv;
+        }
+      }
+      return this.allocateShadowMemory(len, align);
+    },
     freeShadowMemory(dv) {
-      const { address, unalignedAddress, len, align } = dv[ZIG];
+      const { address, unalignedAddress, len, align, type } = dv[ZIG];
+      if (type === MemoryType.Arena) {
+        // freed along with the arena
+        return;
+      }
       if (len) {
         this.freeScratchMemory(unalignedAddress ?? address, len, align);
       }
@@ -270,6 +321,9 @@ export default mixin({
       // Node can read into JavaScript memory space so we can keep shadows there
       return this.allocateJSMemory(len, align);
     },
+    allocateContextMemory(context, len, align) {
+      return this.allocateShadowMemory(len, align);
+    },
     freeShadowMemory(dv) {
       // nothing needs to happen
     },
@@ -354,7 +408,9 @@ export default mixin({
     diagMemoryMapping() {
       const targetSpecific = (process.env.TARGET === 'node') ? [
         `Extern buffer count: ${this.externBufferList.length}`,
-      ] : [];
+      ] : [
+        `Shadow arena count: ${this.shadowArenaCount}`,
+      ];
       this.showDiagnostics('Memory mapping', [
         `Memory list length: ${this.memoryList.length}`,
         `Context count: ${this.contextCount}`,
@@ -373,4 +429,5 @@ function findMemoryIndex(array, address) {
 export const MemoryType = {
   Normal: 0,
   Scratch: 1,
+  Arena: 2,
 };
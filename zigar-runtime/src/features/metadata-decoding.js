@@ -0,0 +1,105 @@
+import { MetadataTag, metadataMagic } from '../constants.js';
+import { mixin } from '../environment.js';
+
+export default mixin({
+  decodeStructures(base64) {
+    // see zigar-compiler/src/metadata-encoding.js for the layout
+    const bytes = (Uint8Array.fromBase64)
+    ? Uint8Array.fromBase64(base64)
+    : Uint8Array.from(atob(base64), c => c.charCodeAt(0));
+    const dv = new DataView(bytes.buffer);
+    const textDecoder = new TextDecoder();
+    let pos = 0;
+    const readUint = () => {
+      let result = 0, multiplier = 1, byte;
+      do {
+        byte = bytes[pos++];
+        result += (byte & 0x7f) * multiplier;
+        multiplier *= 128;
+      } while (byte & 0x80);
+      return result;
+    };
+    const readBigUint = () => {
+      let result = 0n, shift = 0n, byte;
+      do {
+        byte = bytes[pos++];
+        result |= BigInt(byte & 0x7f) << shift;
+        shift += 7n;
+      } while (byte & 0x80);
+      return result;
+    };
+    for (const [ index, byte ] of metadataMagic.entries()) {
+      if (bytes[pos++] !== byte) {
+        throw new Error((index < 3) ? 'Invalid structure metadata' : 'Unsupported metadata version');
+      }
+    }
+    const strings = [];
+    for (let i = 0, count = readUint(); i < count; i++) {
+      const len = readUint();
+      strings.push(textDecoder.decode(bytes.subarray(pos, pos + len)));
+      pos += len;
+    }
+    const buffers = [];
+    for (let i = 0, count = readUint(); i < count; i++) {
+      const len = readUint();
+      // copy the bytes, since objects are created from the whole buffer
+      buffers.push(bytes.slice(pos, pos + len));
+      pos += len;
+    }
+    // create empty objects first, to allow objects to reference each other
+    const structures = [], objects = [];
+    for (let i = 0, count = readUint(); i < count; i++) {
+      structures.push({});
+    }
+    for (let i = 0, count = readUint(); i < count; i++) {
+      objects.push({});
+    }
+    const readValue = () => {
+      const tag = bytes[pos++];
+      switch (tag) {
+        case MetadataTag.Undefined: return undefined;
+        case MetadataTag.Null: return null;
+        case MetadataTag.False: return false;
+        case MetadataTag.True: return true;
+        case MetadataTag.Uint: return readUint();
+        case MetadataTag.NegativeInt: return -readUint();
+        case MetadataTag.Float: {
+          const value = dv.getFloat64(pos, true);
+          pos += 8;
+          return value;
+        }
+        case MetadataTag.String: return strings[readUint()];
+        case MetadataTag.BigInt: return readBigUint();
+        case MetadataTag.NegativeBigInt: return -readBigUint();
+        case MetadataTag.Array: {
+          const list = [];
+          for (let i = 0, count = readUint(); i < count; i++) {
+            list.push(readValue());
+          }
+          return list;
+        }
+        case MetadataTag.Record: {
+          const record = {};
+          for (let i = 0, count = readUint(); i < count; i++) {
+            const key = strings[readUint()];
+            record[key] = readValue();
+          }
+          return record;
+        }
+        case MetadataTag.StructureRef: return structures[readUint()];
+        case MetadataTag.ObjectRef: return objects[readUint()];
+        case MetadataTag.BufferRef: return buffers[readUint()];
+        default: throw new Error(`Unknown metadata tag: ${tag}`);
+      }
+    };
+    for (const structure of structures) {
+      Object.assign(structure, { constructor: null }, readValue());
+    }
+    for (const object of objects) {
+      Object.assign(object, readValue());
+    }
+    const settings = readValue();
+    const root = structures[readUint()];
+    return { structures, root, settings };
+  },
+});
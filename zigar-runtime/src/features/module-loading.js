@@ -159,6 +159,9 @@ export default mixin({
         this.importFunctions(instance.exports);
         this.initializeCustomWASI();
         this.initialize();
+        if (options?.multithreaded) {
+          this.startWorkerPool?.();
+        }
       })();
     },
     getWASIHandler(name) {
@@ -226,18 +229,22 @@ export default mixin({
         let fn = this[name];
         if (fn) {
           if (canReturnPromise) {
-            fn = this.addPromiseHandling(fn);
+            fn = this.addPromiseHandling(fn, name);
           }
           imports[name] = fn.bind(this);
         }
       }
       return imports;
     },
-    addPromiseHandling(fn) {
+    addPromiseHandling(fn, name) {
       const futexIndex = fn.length - 1;
       return function(...args) {
         const futexHandle = args[futexIndex];
         const canWait = !!futexHandle;
+        if (canWait && this.metrics) {
+          // call is coming from another thread
+          this.recordThreadCrossing(name);
+        }
         // replace futexHandle with canWait in the argument list
         args[futexIndex] = canWait;
         const result = fn.call(this, ...args);
@@ -13,46 +13,51 @@ export default mixin({
       }
     }
     for (const { object, handle } of this.variables) {
-      const jsDV = object[MEMORY];
-      // objects in WebAssembly have fixed addresses so the handle is the address
-      // for native code module, locations of objects in memory can change depending on
-      // where the shared library is loaded
-      const address = (process.env.TARGET === 'wasm') ? handle : this.recreateAddress(handle);
-      let zigDV = object[MEMORY] = this.obtainZigView(address, jsDV.byteLength);
-      if (writeBack) {
-        copyView(zigDV, jsDV);
+      this.linkVariable(object, handle, writeBack);
+    }
+    // variables created from this point on (by lazily defined structures) get linked immediately
+    this.variableLinkage = { writeBack };
+    // create thunks of function objects that were created prior to compilation
+    this.createDeferredThunks?.();
+  },
+  linkVariable(object, handle, writeBack) {
+    const jsDV = object[MEMORY];
+    // objects in WebAssembly have fixed addresses so the handle is the address
+    // for native code module, locations of objects in memory can change depending on
+    // where the shared library is loaded
+    const address = (process.env.TARGET === 'wasm') ? handle : this.recreateAddress(handle);
+    let zigDV = object[MEMORY] = this.obtainZigView(address, jsDV.byteLength);
+    if (writeBack) {
+      copyView(zigDV, jsDV);
+    }
+    object.constructor[CACHE]?.save?.(zigDV, object);
+    this.destructors.push(() => {
+      if (process.env.TARGET === 'wasm') {
+        zigDV = this.restoreView(object[MEMORY]);
       }
-      object.constructor[CACHE]?.save?.(zigDV, object);
-      this.destructors.push(() => {
-        if (process.env.TARGET === 'wasm') {
-          zigDV = this.restoreView(object[MEMORY]);
-        }
-        const jsDV = object[MEMORY] = this.allocateMemory(zigDV.byteLength);
-        copyView(jsDV, zigDV);
-      });
-      const linkChildren = (object) => {
-        const slots = object[SLOTS];
-        if (slots) {
-          const parentOffset = zigDV.byteOffset;
-          for (const child of Object.values(slots)) {
-            if (child) {
-              const childDV = child[MEMORY];
-              if (childDV.buffer === jsDV.buffer) {
-                const offset = parentOffset + childDV.byteOffset - jsDV.byteOffset;
-                child[MEMORY] = this.obtainView(zigDV.buffer, offset, childDV.byteLength);
-                child.constructor[CACHE]?.save?.(zigDV, child);
-                linkChildren(child);
-              }
+      const jsDV = object[MEMORY] = this.allocateMemory(zigDV.byteLength);
+      copyView(jsDV, zigDV);
+    });
+    const linkChildren = (object) => {
+      const slots = object[SLOTS];
+      if (slots) {
+        const parentOffset = zigDV.byteOffset;
+        for (const child of Object.values(slots)) {
+          if (child) {
+            const childDV = child[MEMORY];
+            if (childDV.buffer === jsDV.buffer) {
+              const offset = parentOffset + childDV.byteOffset - jsDV.byteOffset;
+              child[MEMORY] = this.obtainView(zigDV.buffer, offset, childDV.byteLength);
+              child.constructor[CACHE]?.save?.(zigDV, child);
+              linkChildren(child);
             }
           }
         }
-      };
-      linkChildren(object);
-      // update pointer targets
-      object[VISIT]?.(function() { this[UPDATE]() }, VisitorFlag.IgnoreInactive);
-    }
-    // create thunks of function objects that were created prior to compilation
-    this.createDeferredThunks?.();
+      }
+    };
+    linkChildren(object);
+    // update pointer targets
+    object[VISIT]?.(function() { this[UPDATE]() }, VisitorFlag.IgnoreInactive);
   },
   ...(process.env.TARGET === 'wasm' ? {
     imports: {
@@ -1,40 +1,65 @@
 import { VisitorFlag } from '../constants.js';
 import { mixin } from '../environment.js';
-import { ADDRESS, LENGTH, MEMORY, SLOTS, UPDATE, VISIT, ZIG } from '../symbols.js';
+import { ADDRESS, ALIGN, GENERATION, LENGTH, MEMORY, SLOTS, UPDATE, VISIT, ZIG } from '../symbols.js';
 import { findSortedIndex } from '../utils.js';
+import { getConditionalVisitCount, getPointerGeneration } from '../visitors/all.js';
 
 export default mixin({
+  init() {
+    this.pointerGraphs = new WeakMap();
+  },
   updatePointerAddresses(context, object) {
     // first, collect all the pointers
     const pointerMap = new Map();
     const bufferMap = new Map();
     const potentialClusters = [];
+    const addTarget = (pointer, target) => {
+      const writable = !pointer.constructor.const;
+      const entry = { target, writable };
+      const dv = target[MEMORY];
+      pointerMap.set(pointer, target);
+      // see if the buffer is shared with other objects
+      const other = bufferMap.get(dv.buffer);
+      if (other) {
+        const array = Array.isArray(other) ? other : [ other ];
+        const index = findSortedIndex(array, dv.byteOffset, e => e.target[MEMORY].byteOffset);
+        array.splice(index, 0, entry);
+        if (!Array.isArray(other)) {
+          bufferMap.set(dv.buffer, array);
+          potentialClusters.push(array);
+        }
+      } else {
+        bufferMap.set(dv.buffer, entry);
+      }
+    };
+    const thisEnv = this;
+    let depth = 0;
     const callback = function(flags) {
       // bypass proxy
       if (pointerMap.get(this) === undefined) {
         const target = this[SLOTS][0];
         if (target) {
-          const writable = !this.constructor.const;
-          const entry = { target, writable };
           // only targets in JS memory need updating
-          const dv = target[MEMORY];
-          if (!dv[ZIG]) {
-            pointerMap.set(this, target);
-            // see if the buffer is shared with other objects
-            const other = bufferMap.get(dv.buffer);
-            if (other) {
-              const array = Array.isArray(other) ? other : [ other ];
-              const index = findSortedIndex(array, dv.byteOffset, e => e.target[MEMORY].byteOffset);
-              array.splice(index, 0, entry);
-              if (!Array.isArray(other)) {
-                bufferMap.set(dv.buffer, array);
-                potentialClusters.push(array);
+          if (!target[MEMORY][ZIG]) {
+            addTarget(this, target);
+            // use pointers found during earlier calls if nothing has changed since
+            const graph = (depth === 0) ? thisEnv.getPointerGraph(target) : null;
+            if (graph) {
+              for (const { pointer, target } of graph) {
+                if (target && pointerMap.get(pointer) === undefined) {
+                  if (!target[MEMORY][ZIG]) {
+                    addTarget(pointer, target);
+                  } else {
+                    pointerMap.set(pointer, null);
+                  }
+                }
               }
             } else {
-              bufferMap.set(dv.buffer, entry);
+              // scan pointers in target
+              depth++;
+              target[VISIT]?.(callback, 0);
+              depth--;
             }
-            // scan pointers in target
-            target[VISIT]?.(callback, 0);
           } else {
             // in Zig memory--no need to update
             pointerMap.set(this, null);
@@ -52,6 +77,10 @@ export default mixin({
         clusterMap.set(target, cluster);
       }
     }
+    if (process.env.TARGET === 'wasm') {
+      // allocate memory for all the shadows in one go
+      this.reserveShadowMemory(context, getShadowSize(object, pointerMap, clusters, clusterMap));
+    }
     // process the pointers
     for (const [ pointer, target ] of pointerMap) {
       if (target) {
@@ -66,6 +95,7 @@ export default mixin({
   },
   updatePointerTargets(context, object, inbound = false) {
     const pointerMap = new Map();
+    const thisEnv = this;
     const callback = function(flags) {
       // bypass proxy
       if (!pointerMap.get(this)) {
@@ -80,7 +110,9 @@ export default mixin({
           // pointers in Zig memory are updated on access so we don't need to do it here
           // (and they should never point to reloctable memory)
           if (currentTarget && !currentTarget[MEMORY][ZIG]) {
-            currentTarget[VISIT]?.(callback, targetFlags);
+            if (!thisEnv.updateGraphTargets(context, currentTarget, pointerMap)) {
+              currentTarget[VISIT]?.(callback, targetFlags);
+            }
           }
         }        
         if (newTarget !== currentTarget) {
@@ -94,6 +126,55 @@ export default mixin({
     const flags = (inbound) ? VisitorFlag.IgnoreRetval : 0;
     object[VISIT](callback, flags);
   },
+  getPointerGraph(target) {
+    if (!target[VISIT]) {
+      return null;
+    }
+    const entry = this.pointerGraphs.get(target);
+    if (!entry) {
+      // don't bother collecting the graph until the object is seen a second time
+      this.pointerGraphs.set(target, { generation: 0, graph: null, reused: false });
+      return null;
+    }
+    if (entry.graph === null) {
+      // undefined is returned when the shape of the graph depends on the content of memory
+      entry.generation = getPointerGeneration();
+      entry.graph = collectPointerGraph(target);
+      entry.reused = false;
+    } else if (entry.graph && !isGraphCurrent(entry)) {
+      // collect it again on the next call only if the graph had proven to be stable
+      entry.graph = (entry.reused) ? null : undefined;
+      return null;
+    }
+    if (entry.graph) {
+      entry.reused = true;
+    }
+    return entry.graph ?? null;
+  },
+  updateGraphTargets(context, target, pointerMap) {
+    const entry = this.pointerGraphs.get(target);
+    if (!entry?.graph || !isGraphCurrent(entry)) {
+      return false;
+    }
+    const generation = getPointerGeneration();
+    const updated = [];
+    for (const { pointer, immutable } of entry.graph) {
+      if (!immutable && !pointerMap.get(pointer)) {
+        pointerMap.set(pointer, true);
+        updated.push(pointer);
+        pointer[UPDATE](context, true, true);
+      }
+    }
+    if (getPointerGeneration() !== generation) {
+      // Zig has changed some of the pointers; go through the graph the regular way, which would
+      // pick up any new targets
+      for (const pointer of updated) {
+        pointerMap.delete(pointer);
+      }
+      return false;
+    }
+    return true;
+  },
   findTargetClusters(potentialClusters) {
     const clusters = [];
     for (const entries of potentialClusters) {
@@ -142,3 +223,68 @@ export default mixin({
     return clusters;
   },
 });
+
+function getShadowSize(object, pointerMap, clusters, clusterMap) {
+  // include room for alignment adjustments
+  const getSize = (target) => {
+    const dv = target[MEMORY];
+    const len = dv.byteLength;
+    return (len > 0) ? len + ((target.constructor[ALIGN] ?? dv[ALIGN]) || 1) : 0;
+  };
+  let size = 0;
+  const seen = new Set();
+  for (const target of pointerMap.values()) {
+    if (target && !clusterMap.get(target) && !seen.has(target)) {
+      seen.add(target);
+      size += getSize(target);
+    }
+  }
+  for (const { start, end, targets } of clusters) {
+    let maxAlign = 1;
+    for (const target of targets) {
+      const dv = target[MEMORY];
+      maxAlign = Math.max(maxAlign, (target.constructor[ALIGN] ?? dv[ALIGN]) || 1);
+    }
+    size += end - start + maxAlign;
+  }
+  // the object itself (i.e. the argument struct) needs shadowing too
+  if (!object[MEMORY][ZIG]) {
+    size += getSize(object);
+  }
+  return size;
+}
+
+function collectPointerGraph(root) {
+  // list every pointer reachable from the root, including those that are currently null, noting
+  // whether it's reached through a const pointer
+  const graph = [];
+  const seen = new Map();
+  const conditionalCount = getConditionalVisitCount();
+  const callback = function(flags) {
+    if (!seen.get(this)) {
+      seen.set(this, true);
+      const target = this[SLOTS][0];
+      const immutable = !!(flags & VisitorFlag.IsImmutable);
+      graph.push({ pointer: this, target, immutable });
+      if (target && !target[MEMORY][ZIG]) {
+        const targetFlags = (immutable || this.constructor.const) ? VisitorFlag.IsImmutable : 0;
+        target[VISIT]?.(callback, targetFlags);
+      }
+    }
+  };
+  root[VISIT](callback, 0);
+  if (getConditionalVisitCount() !== conditionalCount) {
+    return undefined;
+  }
+  return graph;
+}
+
+function isGraphCurrent({ graph, generation }) {
+  // every pointer records the generation number at which its target was last changed
+  for (const { pointer } of graph) {
+    if (pointer[GENERATION] > generation) {
+      return false;
+    }
+  }
+  return true;
+}
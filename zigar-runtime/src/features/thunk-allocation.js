@@ -13,7 +13,9 @@ export default mixin({
     },
     init() {
       this.thunkSources = [];
+      this.thunkSourceLists = new Map();
       this.thunkMap = new Map();
+      this.freeTableSlots = [];
     },
     addJsThunkSource() {
       const {
@@ -34,7 +36,7 @@ export default mixin({
           }
         }
       }
-      env.memory = new w.Memory({
+      const memory = env.memory = new w.Memory({
         initial: memoryInitial ?? this.memory.buffer.byteLength / 65536,
         maximum: memoryMax,
         shared: multithreaded,
@@ -43,6 +45,9 @@ export default mixin({
         initial: tableInitial,
         element: 'anyfunc',
       });
+      // calls to JavaScript functions are made through thunks in the main instance
+      env._handleJscall = (id, argAddress, argSize) => this.relayJscall(memory, id, argAddress, argSize);
+      env._releaseFunction = (id) => this.releaseFunction(id);
       const { exports } = new w.Instance(this.executable, imports);
       const { createJsThunk, destroyJsThunk, identifyJsThunk } = exports;
       const source = {
@@ -51,35 +56,51 @@ export default mixin({
         destroyJsThunk,
         identifyJsThunk,
         table,
+        // controllers for which this instance has run out of thunks
+        exhausted: new Set(),
       };
-      this.thunkSources.unshift(source);
+      this.thunkSources.push(source);
       return source;
     },
+    relayJscall(memory, id, argAddress, argSize) {
+      // the argument struct is in the memory of the other instance; copy it into the main
+      // instance's memory, then copy it back afterward so the return value is seen
+      const shadowDV = this.allocateShadowMemory(argSize, 16);
+      const address = this.getViewAddress(shadowDV);
+      try {
+        this.moveExternBytes(new Uint8Array(memory.buffer, argAddress, argSize), address, true);
+        const result = this.handleJscall(id, address, argSize, false);
+        // main memory might have grown during the call, so don't reuse the view
+        this.moveExternBytes(new Uint8Array(memory.buffer, argAddress, argSize), address, false);
+        return result;
+      } finally {
+        this.freeShadowMemory(shadowDV);
+      }
+    },
     allocateJsThunk(controllerAddress, funcId) {
-      let source, sourceAddress = 0;
-      for (source of this.thunkSources) {
-        sourceAddress = source.createJsThunk(controllerAddress, funcId);
-        break;
+      // sources that still have thunks for this controller
+      let list = this.thunkSourceLists.get(controllerAddress);
+      if (!list) {
+        this.thunkSourceLists.set(controllerAddress, list = []);
       }
-      if (!sourceAddress) {
-        source = this.addJsThunkSource();
+      let source, sourceAddress = 0;
+      while (!sourceAddress) {
+        source = list[list.length - 1];
+        if (!source) {
+          source = this.addJsThunkSource();
+          list.push(source);
+        }
         sourceAddress = source.createJsThunk(controllerAddress, funcId);
+        if (!sourceAddress) {
+          list.pop();
+          source.exhausted.add(controllerAddress);
+        }
       }
       // sourceAddress is an index into the function table of the source instance
       // we need to get the function object and place it into the main instance's
       // function table
       const thunkObject = source.table.get(sourceAddress);
-      let thunkAddress = 0;
-      for (let i = this.table.length - 1; i >= this.initialTableLength; i--) {
-        if (!this.table.get(i)) {
-          thunkAddress = i;
-          break;
-        }
-      }
-      if (!thunkAddress) {
-        thunkAddress = this.table.length;
-        this.table.grow(8);
-      }
+      const thunkAddress = this.allocateTableSlot();
       this.table.set(thunkAddress, thunkObject);
       source.thunkCount++;
       // remember where the object is from
@@ -89,25 +110,24 @@ export default mixin({
     freeJsThunk(controllerAddress, thunkAddress) {
       let fnId = 0;
       const thunkObject = this.table.get(thunkAddress);
-      this.table.set(thunkAddress, null);
       const entry = this.thunkMap.get(thunkObject);
       if (entry) {
         const { source, sourceAddress } = entry;
         fnId = source.destroyJsThunk(controllerAddress, sourceAddress);
-        if (--source.thunkCount === 0) {
-          const index = this.thunkSources.indexOf(source);
-          if (index !== -1) {
-            this.thunkSources.splice(index, 1);
-          }
-        }
         this.thunkMap.delete(thunkObject);
+        this.table.set(thunkAddress, null);
+        this.freeTableSlots.push(thunkAddress);
+        source.thunkCount--;
+        if (source.exhausted.delete(controllerAddress)) {
+          // the freed thunk can be handed out again
+          this.thunkSourceLists.get(controllerAddress)?.push(source);
+        }
       }
       return fnId;
     },
     findJsThunk(controllerAddress, thunkAddress) {
       let fnId = 0;
       const thunkObject = this.table.get(thunkAddress);
-      this.table.set(thunkAddress, null);
       const entry = this.thunkMap.get(thunkObject);
       if (entry) {
         const { source, sourceAddress } = entry;
@@ -115,5 +135,29 @@ export default mixin({
       }
       return fnId;
     },
+    allocateTableSlot() {
+      if (this.freeTableSlots.length === 0) {
+        // double the number of slots past the initial length each time
+        const start = this.table.length;
+        const count = Math.max(8, start - this.initialTableLength);
+        this.table.grow(count);
+        for (let i = start + count - 1; i >= start; i--) {
+          this.freeTableSlots.push(i);
+        }
+      }
+      return this.freeTableSlots.pop();
+    },
+    /* c8 ignore start */
+    ...(process.env.DEV ? {
+      diagThunkAllocation() {
+        this.showDiagnostics('Thunk allocation', [
+          `Extra instance count: ${this.thunkSources.length}`,
+          `Extra thunk count: ${this.thunkMap.size}`,
+          `Function table size: ${this.table?.length ?? 0}`,
+          `Free table slots: ${this.freeTableSlots.length}`,
+        ]);
+      }
+    } : undefined),
+    /* c8 ignore end */
   } : undefined),
 });
@@ -3,10 +3,23 @@ import { isPromise, remove } from '../utils.js';
 
 let NodeWorker;
 
+// number of idle workers kept around when workerPoolSize isn't given
+const defaultWorkerPoolSize = 4;
+
 export default mixin({
   init() {
     this.nextThreadId = 1;
     this.workers = [];
+    this.idleWorkers = [];
+    this.workerStats = {
+      spawns: 0,
+      poolHits: 0,
+      poolMisses: 0,
+      // clean-ups of cancelled threads also go through obtainWorker() but don't report latency
+      timedSpawns: 0,
+      totalSpawnLatency: 0,
+      maxSpawnLatency: 0,
+    };
     if (process.env.COMPAT === 'node') {
       if (typeof(Worker) !== 'function') {
         import('node:worker_threads').then((m) => NodeWorker = m.Worker);
@@ -36,10 +49,76 @@ export default mixin({
     if (this.nextThreadId === 0x4000_0000) {
       this.nextThreadId = 1;
     }
-    const worker = this.createWorker();
+    const worker = this.obtainWorker();
     worker.run(tid, taddr);
     return tid;
   },
+  getWorkerPoolSize() {
+    return this.options?.workerPoolSize ?? defaultWorkerPoolSize;
+  },
+  startWorkerPool() {
+    // create workers ahead of time so the module is already instantiated by the time a thread
+    // gets spawned
+    const size = this.getWorkerPoolSize();
+    while (this.idleWorkers.length < size) {
+      this.parkWorker(this.createWorker());
+    }
+    this.destructors.push(() => {
+      for (const worker of [ ...this.idleWorkers ]) {
+        worker.end();
+      }
+    });
+  },
+  obtainWorker() {
+    const stats = this.workerStats;
+    stats.spawns++;
+    let worker = this.idleWorkers.pop();
+    if (worker) {
+      stats.poolHits++;
+      worker.ref?.();
+    } else {
+      stats.poolMisses++;
+      worker = this.createWorker();
+    }
+    return worker;
+  },
+  releaseWorker(worker) {
+    if (!worker.terminated && this.idleWorkers.length < this.getWorkerPoolSize()) {
+      worker.tid = 0;
+      worker.taddr = 0;
+      worker.canceled = false;
+      this.parkWorker(worker);
+    } else {
+      worker.end();
+    }
+  },
+  parkWorker(worker) {
+    // idle Node.js workers shouldn't keep the process alive
+    worker.unref?.();
+    this.idleWorkers.push(worker);
+  },
+  recordSpawnLatency(latency) {
+    if (!(latency >= 0)) return;
+    const stats = this.workerStats;
+    stats.timedSpawns++;
+    stats.totalSpawnLatency += latency;
+    if (latency > stats.maxSpawnLatency) {
+      stats.maxSpawnLatency = latency;
+    }
+  },
+  getWorkerStatistics() {
+    const { spawns, poolHits, poolMisses, timedSpawns, totalSpawnLatency, maxSpawnLatency } = this.workerStats;
+    return {
+      spawns,
+      poolHits,
+      poolMisses,
+      hitRate: (spawns > 0) ? poolHits / spawns : 0,
+      averageSpawnLatency: (timedSpawns > 0) ? totalSpawnLatency / timedSpawns : 0,
+      maxSpawnLatency,
+      activeWorkers: this.workers.length - this.idleWorkers.length,
+      idleWorkers: this.idleWorkers.length,
+    };
+  },
   cancelThread(tid, raddr) {
     const worker = this.workers.find(w => w.tid === tid);
     if (worker) {
@@ -48,8 +127,8 @@ export default mixin({
         worker.canceled = true;
       } else {
         worker.end(true);
-        // create a replacement worker that'll perform the thread clean-up
-        const scab = this.createWorker();
+        // use a different worker to perform the thread clean-up
+        const scab = this.obtainWorker();
         scab.clean(raddr);
       }
     }
@@ -64,6 +143,9 @@ export default mixin({
         case 'call': {
           const { module, name, args, futex } = msg;        
           if (!worker.canceled) {
+            if (this.metrics) {
+              this.recordThreadCrossing(name);
+            }
             const fn = this.exportedModules[module]?.[name];
             // add a true argument to indicate that waiting is possible
             const result = fn?.(...args, true);
@@ -81,7 +163,8 @@ export default mixin({
           }
         } break;
         case 'done': {
-          worker.end();
+          this.recordSpawnLatency(msg.latency);
+          this.releaseWorker(worker);
         } break;
       }
     };
@@ -114,7 +197,9 @@ export default mixin({
       worker.tid = tid;
       worker.taddr = taddr;
       worker.canceled = false;
-      worker.postMessage({ type: 'run', tid, taddr });
+      // time is measured against the time origin since workers have their own
+      const time = performance.timeOrigin + performance.now();
+      worker.postMessage({ type: 'run', tid, taddr, time });
     };
     worker.clean = (raddr) => {
       worker.postMessage({ type: 'clean', raddr });
@@ -122,10 +207,12 @@ export default mixin({
     worker.end = (force = false) => {
       if (force) {
         worker.terminate();
+        worker.terminated = true;
       } else {
         worker.postMessage({ type: 'end' });
       }
       remove(this.workers, worker);
+      remove(this.idleWorkers, worker);
     };
     this.workers.push(worker);
     return worker;
@@ -133,9 +220,15 @@ export default mixin({
   /* c8 ignore start */
   ...(process.env.DEV ? {
     diagWorkerSupport() {
+      const stats = this.getWorkerStatistics();
       this.showDiagnostics('Worker support', [
         `Worker count: ${this.workers.length}`,
+        `Idle worker count: ${stats.idleWorkers}`,
         `Next thread id: ${this.nextThreadId}`,
+        `Thread spawn count: ${stats.spawns}`,
+        `Pool hit rate: ${(stats.hitRate * 100).toFixed(1)}%`,
+        `Average spawn latency: ${stats.averageSpawnLatency.toFixed(2)}ms`,
+        `Maximum spawn latency: ${stats.maxSpawnLatency.toFixed(2)}ms`,
       ]);
     }
   } : undefined),
@@ -260,12 +353,13 @@ function workerMain() {
         instance = new WA.Instance(executable, imports)
       } break;
       case 'run': {
+        const latency = performance.timeOrigin + performance.now() - msg.time;
         // catch thread termination exception
         try {
           instance.exports.wasi_thread_start(msg.tid, msg.taddr);
         } catch {
         }
-        port.postMessage({ type: 'done' });
+        port.postMessage({ type: 'done', latency });
       } break;
       case 'clean': {
         try {
@@ -0,0 +1,181 @@
+import { MemberType, StructureType } from '../constants.js';
+import { mixin } from '../environment.js';
+import { ArrayLengthMismatch, NoProperty, Overflow, throwReadOnly, TypeMismatch } from '../errors.js';
+import { getIntRange } from '../features/runtime-safety.js';
+import { MEMORY, READ_ONLY, RESTORE } from '../symbols.js';
+
+// move numeric fields of an array of structs to and from typed arrays, one column at a time,
+// without creating objects for the elements
+
+export default mixin({
+  getColumns(structure) {
+    const { instance: { members: [ member ] } } = structure;
+    const { byteSize: stride, structure: elementStructure } = member;
+    const columns = [];
+    if (elementStructure.type === StructureType.Struct && stride > 0) {
+      for (const field of elementStructure.instance.members) {
+        const TypedArray = getColumnType(field);
+        if (TypedArray && field.name !== undefined && field.bitOffset !== undefined) {
+          const { name, type, bitOffset, bitSize, byteSize } = field;
+          const offset = bitOffset >> 3;
+          // fields that line up with elements of a typed array can be accessed directly
+          const direct = type !== MemberType.Bool && !(bitOffset & 0x07)
+                      && bitSize === TypedArray.BYTES_PER_ELEMENT * 8
+                      && byteSize === TypedArray.BYTES_PER_ELEMENT
+                      && stride % byteSize === 0 && offset % byteSize === 0;
+          const getter = this.getAccessor('get', field);
+          let getSetter = this.getAccessor;
+          let range = null;
+          if (type === MemberType.Int || type === MemberType.Uint) {
+            // values are checked and converted the same way as when they're set through a struct
+            if (this.runtimeSafety) {
+              getSetter = this.addRuntimeCheck(getSetter);
+              range = getIntRange(field);
+            }
+            getSetter = this.addIntConversion(getSetter);
+          }
+          const setter = getSetter.call(this, 'set', field);
+          columns.push({ name, type, TypedArray, offset, direct, getter, setter, field, range });
+        }
+      }
+    }
+    return columns;
+  },
+  defineColumns(structure) {
+    const columns = this.getColumns(structure);
+    if (columns.length === 0) {
+      return {};
+    }
+    const { instance: { members: [ { byteSize: stride } ] } } = structure;
+    const { littleEndian } = this;
+    const useView = (dv, column, length) => {
+      // a typed array can't start past the end of an empty buffer
+      if (!column.direct || length === 0 || littleEndian !== hostLittleEndian) {
+        return false;
+      }
+      if (process.env.TARGET === 'node') {
+        // changes need to be copied into fallback buffer
+        if (this.usingBufferFallback()) {
+          return false;
+        }
+      }
+      return (dv.byteOffset + column.offset) % column.TypedArray.BYTES_PER_ELEMENT === 0;
+    };
+    const getView = (dv, column, length) => {
+      const { TypedArray, offset } = column;
+      const step = stride / TypedArray.BYTES_PER_ELEMENT;
+      return new TypedArray(dv.buffer, dv.byteOffset + offset, (length - 1) * step + 1);
+    };
+    return {
+      toColumns: {
+        value() {
+          const dv = (process.env.TARGET === 'wasm') ? this[RESTORE]() : this[MEMORY];
+          const { length } = this;
+          const result = {};
+          for (const column of columns) {
+            const { name, type, TypedArray, offset, getter } = column;
+            const array = new TypedArray(length);
+            if (useView(dv, column, length)) {
+              const view = getView(dv, column, length);
+              const step = stride / TypedArray.BYTES_PER_ELEMENT;
+              for (let i = 0, j = 0; i < length; i++, j += step) {
+                array[i] = view[j];
+              }
+            } else if (type === MemberType.Bool) {
+              for (let i = 0, o = offset; i < length; i++, o += stride) {
+                array[i] = getter.call(dv, o, littleEndian) ? 1 : 0;
+              }
+            } else {
+              for (let i = 0, o = offset; i < length; i++, o += stride) {
+                array[i] = getter.call(dv, o, littleEndian);
+              }
+            }
+            result[name] = array;
+          }
+          return result;
+        },
+      },
+      fromColumns: {
+        value(arg) {
+          if (this[READ_ONLY]) {
+            throwReadOnly();
+          }
+          if (!arg || typeof(arg) !== 'object') {
+            throw new TypeMismatch('object', arg);
+          }
+          const dv = (process.env.TARGET === 'wasm') ? this[RESTORE]() : this[MEMORY];
+          const { length } = this;
+          for (const [ name, array ] of Object.entries(arg)) {
+            const column = columns.find(c => c.name === name);
+            if (!column) {
+              throw new NoProperty(structure.instance.members[0].structure, name);
+            }
+            if (array?.length !== length) {
+              throw new ArrayLengthMismatch(structure, this, array);
+            }
+            const { type, TypedArray, offset, setter, field, range } = column;
+            // numbers need to be converted to bigints by the setter
+            const converting = isBigIntArray(TypedArray) && !(array instanceof TypedArray);
+            if (!converting && useView(dv, column, length)) {
+              const view = getView(dv, column, length);
+              const step = stride / TypedArray.BYTES_PER_ELEMENT;
+              if (range && !(array instanceof TypedArray)) {
+                // a typed array would wrap out-of-range values silently
+                const { min, max } = range;
+                for (let i = 0, j = 0; i < length; i++, j += step) {
+                  const value = array[i];
+                  if (value < min || value > max) {
+                    throw new Overflow(field, value);
+                  }
+                  view[j] = value;
+                }
+              } else {
+                for (let i = 0, j = 0; i < length; i++, j += step) {
+                  view[j] = array[i];
+                }
+              }
+            } else if (type === MemberType.Bool) {
+              for (let i = 0, o = offset; i < length; i++, o += stride) {
+                setter.call(dv, o, !!array[i], littleEndian);
+              }
+            } else {
+              for (let i = 0, o = offset; i < length; i++, o += stride) {
+                setter.call(dv, o, array[i], littleEndian);
+              }
+            }
+          }
+          return this;
+        },
+      },
+    };
+  },
+});
+
+const hostLittleEndian = new Uint8Array(new Uint16Array([ 1 ]).buffer)[0] === 1;
+
+function isBigIntArray(TypedArray) {
+  return TypedArray === BigInt64Array || TypedArray === BigUint64Array;
+}
+
+function getColumnType(member) {
+  const { type, bitSize } = member;
+  switch (type) {
+    case MemberType.Bool:
+      return Uint8Array;
+    case MemberType.Int:
+      if (bitSize <= 8) return Int8Array;
+      if (bitSize <= 16) return Int16Array;
+      if (bitSize <= 32) return Int32Array;
+      if (bitSize <= 64) return BigInt64Array;
+      break;
+    case MemberType.Uint:
+      if (bitSize <= 8) return Uint8Array;
+      if (bitSize <= 16) return Uint16Array;
+      if (bitSize <= 32) return Uint32Array;
+      if (bitSize <= 64) return BigUint64Array;
+      break;
+    case MemberType.Float:
+      // f16 is widened, f80 and f128 are narrowed
+      return (bitSize <= 32) ? Float32Array : Float64Array;
+  }
+}
@@ -1,7 +1,7 @@
-import { StructFlag, StructureType } from '../constants.js';
+import { MemberFlag, MemberType, StructFlag, StructureFlag, StructureType } from '../constants.js';
 import { mixin } from '../environment.js';
-import { ENTRIES, FLAGS, TYPE } from '../symbols.js';
-import { getErrorHandler } from '../utils.js';
+import { ENTRIES, FLAGS, MEMORY, RESTORE, SERIALIZE, TYPE } from '../symbols.js';
+import { defineValue, getErrorHandler } from '../utils.js';
 
 export default mixin({
   defineValueOf() {
@@ -11,12 +11,175 @@ export default mixin({
       },
     };
   },
+  defineSerializer(structure) {
+    const thisEnv = this;
+    // serializers are created on first use, since structures referenced by this one might not
+    // be complete at this point
+    const serializers = {};
+    return defineValue(function(forJSON) {
+      let serialize = serializers[forJSON];
+      if (serialize === undefined) {
+        serialize = serializers[forJSON] = thisEnv.createSerializer(structure, forJSON);
+      }
+      return serialize?.(this);
+    });
+  },
+  createSerializer(structure, forJSON) {
+    const { type } = structure;
+    if (type === StructureType.Slice) {
+      const { instance: { members: [ member ] } } = structure;
+      const read = this.createElementReader(member, forJSON);
+      if (!read) {
+        return null;
+      }
+      const { byteSize } = member;
+      return function(object) {
+        const dv = (process.env.TARGET === 'wasm') ? object[RESTORE]() : object[MEMORY];
+        const { length } = object;
+        const result = new Array(length);
+        for (let i = 0, offset = 0; i < length; i++, offset += byteSize) {
+          result[i] = read(dv, offset);
+        }
+        return result;
+      };
+    } else {
+      const read = this.createStructureReader(structure, forJSON);
+      if (!read) {
+        return null;
+      }
+      return function(object) {
+        const dv = (process.env.TARGET === 'wasm') ? object[RESTORE]() : object[MEMORY];
+        return read(dv, 0);
+      };
+    }
+  },
+  createStructureReader(structure, forJSON) {
+    // only structures without pointers are handled here, as they cannot contain cycles nor
+    // refer to the same object more than once
+    const { type, flags, instance: { members } } = structure;
+    if (flags & StructureFlag.HasPointer) {
+      return null;
+    }
+    switch (type) {
+      case StructureType.Struct: {
+        const fields = [];
+        for (const member of members.filter(m => !!m.name)) {
+          const read = this.createFieldReader(member, forJSON);
+          if (!read) {
+            return null;
+          }
+          fields.push({ name: member.name, read });
+        }
+        const isTuple = !!(flags & StructFlag.IsTuple);
+        const count = fields.length;
+        return function(dv, offset) {
+          const result = (isTuple) ? [] : {};
+          for (let i = 0; i < count; i++) {
+            const field = fields[i];
+            result[field.name] = field.read(dv, offset);
+          }
+          return result;
+        };
+      }
+      case StructureType.Vector: {
+        // elements of vectors can be bit-aligned
+        const [ member ] = members;
+        const { length } = structure;
+        const elements = [];
+        for (let i = 0, bitOffset = 0; i < length; i++, bitOffset += member.bitSize) {
+          const read = this.createPrimitiveReader({ ...member, bitOffset }, bitOffset >> 3, forJSON);
+          if (!read) {
+            return null;
+          }
+          elements.push(read);
+        }
+        return function(dv, offset) {
+          const result = new Array(length);
+          for (let i = 0; i < length; i++) {
+            result[i] = elements[i](dv, offset);
+          }
+          return result;
+        };
+      }
+      case StructureType.Array: {
+        const { length } = structure;
+        const [ member ] = members;
+        const read = this.createElementReader(member, forJSON);
+        if (!read) {
+          return null;
+        }
+        const { byteSize } = member;
+        return function(dv, offset) {
+          const result = new Array(length);
+          for (let i = 0, o = offset; i < length; i++, o += byteSize) {
+            result[i] = read(dv, o);
+          }
+          return result;
+        };
+      }
+      default:
+        return null;
+    }
+  },
+  createFieldReader(member, forJSON) {
+    const { type, bitOffset, structure } = member;
+    if (bitOffset === undefined) {
+      // comptime field
+      return null;
+    }
+    if (type === MemberType.Object) {
+      if (bitOffset & 0x07 || member.flags & (MemberFlag.IsString | MemberFlag.IsTypedArray | MemberFlag.IsClampedArray)) {
+        return null;
+      }
+      const read = this.createStructureReader(structure, forJSON);
+      if (!read) {
+        return null;
+      }
+      const fieldOffset = bitOffset >> 3;
+      return (dv, offset) => read(dv, offset + fieldOffset);
+    } else {
+      return this.createPrimitiveReader(member, bitOffset >> 3, forJSON);
+    }
+  },
+  createElementReader(member, forJSON) {
+    const { type, structure } = member;
+    if (type === MemberType.Object) {
+      return this.createStructureReader(structure, forJSON);
+    } else {
+      return this.createPrimitiveReader(member, 0, forJSON);
+    }
+  },
+  createPrimitiveReader(member, fieldOffset, forJSON) {
+    const { type, bitSize, structure } = member;
+    if (type === MemberType.Void) {
+      return () => undefined;
+    }
+    if (type !== MemberType.Bool && type !== MemberType.Int && type !== MemberType.Uint && type !== MemberType.Float) {
+      return null;
+    }
+    if (structure?.type !== undefined && structure.type !== StructureType.Primitive) {
+      // enums and error sets need to be looked up
+      return null;
+    }
+    const isInt = type === MemberType.Int || type === MemberType.Uint;
+    const getter = (isInt)
+    ? this.addIntConversion(this.getAccessor).call(this, 'get', member)
+    : this.getAccessor('get', member);
+    const { littleEndian } = this;
+    if (forJSON && isInt && bitSize > 32) {
+      return (dv, offset) => {
+        const value = getter.call(dv, offset + fieldOffset, littleEndian);
+        return (typeof(value) === 'bigint' && INT_MIN <= value && value <= INT_MAX) ? Number(value) : value;
+      };
+    }
+    return (dv, offset) => getter.call(dv, offset + fieldOffset, littleEndian);
+  },
 });
 
 const INT_MAX = BigInt(Number.MAX_SAFE_INTEGER);
 const INT_MIN = BigInt(Number.MIN_SAFE_INTEGER);
 
-export function normalizeObject(object, forJSON) {
+export function normalizeObject(object, forJSON, useSerializer = true) {
   const options = { error: (forJSON) ? 'return' : 'throw' };
   const handleError = getErrorHandler(options);
   const resultMap = new Map();
@@ -35,6 +198,13 @@ export function normalizeObject(object, forJSON) {
     }
     let result = resultMap.get(value);
     if (result === undefined) {
+      if (useSerializer && typeof(value) === 'object') {
+        // use serializer that reads directly from memory when the structure allows it
+        result = value[SERIALIZE]?.(forJSON);
+        if (result !== undefined) {
+          return result;
+        }
+      }
       let entries;
       switch (type) {
         case StructureType.Struct:
@@ -79,5 +249,3 @@ export function normalizeObject(object, forJSON) {
   };
   return process(object);
 }
-
-
@@ -19,9 +19,11 @@ export { default as FeatureAllocatorMethods } from './features/allocator-methods
 export { default as FeatureBaseline } from './features/baseline.js';
 export { default as FeatureCallMarshalingInbound } from './features/call-marshaling-inbound.js';
 export { default as FeatureCallMarshalingOutbound } from './features/call-marshaling-outbound.js';
+export { default as FeatureCallMetrics } from './features/call-metrics.js';
 export { default as FeatureDirConversion } from './features/dir-conversion.js';
 export { default as FeatureIntConversion } from './features/int-conversion.js';
 export { default as FeatureMemoryMapping } from './features/memory-mapping.js';
+export { default as FeatureMetadataDecoding } from './features/metadata-decoding.js';
 export { default as FeatureModuleLoading } from './features/module-loading.js';
 export { default as FeatureObjectLinkage } from './features/object-linkage.js';
 export { default as FeaturePointerSynchronization } from './features/pointer-synchronization.js';
@@ -44,6 +46,7 @@ export { default as MemberAll } from './members/all.js';
 export { default as MemberBase64 } from './members/base64.js';
 export { default as MemberBool } from './members/bool.js';
 export { default as MemberClampedArray } from './members/clamped-array.js';
+export { default as MemberColumns } from './members/columns.js';
 export { default as MemberDataView } from './members/data-view.js';
 export { default as MemberFloat } from './members/float.js';
 export { default as MemberInt } from './members/int.js';
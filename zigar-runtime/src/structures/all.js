@@ -6,7 +6,7 @@ import { MissingInitializers, NoInitializer, NoProperty, throwNoSupport } from '
 import { removeProxy } from '../proxies.js';
 import {
   ALIGN, CACHE, CAST, ENTRIES, ENVIRONMENT, FINALIZE, FLAGS, INITIALIZE, KEYS, MEMORY, PROPS,
-  PROXY, RESTORE, RESTRICT, SETTERS, SHAPE, SIGNATURE, SIZE, SLOTS, TRANSFORM, TYPE, TYPED_ARRAY,
+  PROXY, RESTORE, RESTRICT, SERIALIZE, SETTERS, SHAPE, SIGNATURE, SIZE, SLOTS, TRANSFORM, TYPE, TYPED_ARRAY,
   UPDATE
 } from '../symbols.js';
 import { copyObject, defineProperties, defineProperty, defineValue, ObjectCache } from '../utils.js';
@@ -34,6 +34,7 @@ export default mixin({
       base64: this.defineBase64(structure),
       toJSON: this.defineToJSON(),
       valueOf: this.defineValueOf(),
+      [SERIALIZE]: this.defineSerializer(structure),
       [SETTERS]: defineValue(setters),
       [KEYS]: defineValue(keys),
       ...(process.env.TARGET === 'wasm' ? {
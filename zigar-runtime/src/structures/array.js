@@ -74,6 +74,9 @@ export default mixin({
     if (!(flags & ArrayFlag.IsString) && this.hasStringProperty(structure)) {
       descriptors.string = this.defineStringArray(structure);
     }
+    const { toColumns, fromColumns } = this.defineColumns(structure);
+    descriptors.toColumns = toColumns;
+    descriptors.fromColumns = fromColumns;
     descriptors[Symbol.iterator] = this.defineArrayIterator();
     descriptors[INITIALIZE] = defineValue(initializer);
     descriptors[FINALIZE] = this.defineFinalizerArray(descriptor);
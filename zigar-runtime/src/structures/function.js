@@ -40,7 +40,7 @@ export default mixin({
       const argCount = ArgStruct.prototype.length;
       const self = (creating)
       ? thisEnv.createInboundCaller(arg, ArgStruct)
-      : thisEnv.createOutboundCaller(thunk, ArgStruct);
+      : thisEnv.createOutboundCaller(thunk, ArgStruct, member.structure);
       defineProperties(self, {
         length: defineValue(argCount),
         name: defineValue(creating ? arg.name : ''),
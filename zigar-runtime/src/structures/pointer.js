@@ -6,13 +6,14 @@ import {
 } from '../errors.js';
 import { getProxy, getProxyTarget, getProxyType } from '../proxies.js';
 import {
-  ADDRESS, CAST, ENVIRONMENT, FINALIZE, INITIALIZE, LAST_ADDRESS, LAST_LENGTH, LENGTH, MAX_LENGTH,
+  ADDRESS, CAST, ENVIRONMENT, FINALIZE, GENERATION, INITIALIZE, LAST_ADDRESS, LAST_LENGTH, LENGTH, MAX_LENGTH,
   MEMORY, PARENT, PROXY, PROXY_TYPE, READ_ONLY, RESTORE, SENTINEL, SETTERS, SIZE, SLOTS, TARGET, TYPE,
   TYPED_ARRAY, UPDATE, VISIT, ZIG
 } from '../symbols.js';
 import {
   defineValue, findElements, getSelf, isCompatibleInstanceOf, isCompatibleType, usizeInvalid
 } from '../utils.js';
+import { markPointerChange } from '../visitors/all.js';
 
 export default mixin({
   definePointer(structure, descriptors) {
@@ -43,6 +44,7 @@ export default mixin({
             const dv = thisEnv.findMemory(context, address, length, Target[SIZE]);
             const newTarget = (dv) ? Target.call(ENVIRONMENT, dv) : null;
             this[SLOTS][0] = newTarget;
+            markPointerChange(this);
             this[LAST_ADDRESS] = address;
             this[LAST_LENGTH] = length;
             if (flags & PointerFlag.HasLength) {
@@ -51,6 +53,7 @@ export default mixin({
             return newTarget;
           }
         } else {
+          markPointerChange(this);
           return this[SLOTS][0] = undefined;
         }
       }
@@ -105,6 +108,7 @@ export default mixin({
         setLength?.call?.(this, 0);
       }
       this[SLOTS][0] = arg ?? null;
+      markPointerChange(this);
       if (flags & PointerFlag.HasLength) {
         this[MAX_LENGTH] = null;
       }
@@ -157,6 +161,7 @@ export default mixin({
       : thisEnv.obtainView(dv.buffer, dv.byteOffset, byteLength);
       const Target = targetStructure.constructor;
       this[SLOTS][0] = Target.call(ENVIRONMENT, newDV);
+      markPointerChange(this);
       setLength?.call?.(this, len);
     };
     const thisEnv = this;
@@ -299,6 +304,7 @@ export default mixin({
     descriptors[VISIT] = this.defineVisitor();
     descriptors[LAST_ADDRESS] = defineValue(0);
     descriptors[LAST_LENGTH] = defineValue(0);
+    descriptors[GENERATION] = defineValue(0);
     descriptors[MAX_LENGTH] = (flags & PointerFlag.HasLength) && defineValue(null);
     // disable these so the target's properties are returned instead through auto-dereferencing
     descriptors.dataView = descriptors.base64 = undefined;
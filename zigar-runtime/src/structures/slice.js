@@ -133,6 +133,9 @@ export default mixin({
         return slice;
       },
     };
+    const { toColumns, fromColumns } = this.defineColumns(structure);
+    descriptors.toColumns = toColumns;
+    descriptors.fromColumns = fromColumns;
     descriptors[Symbol.iterator] = this.defineArrayIterator();
     descriptors[SHAPE] = defineValue(shapeDefiner);
     descriptors[INITIALIZE] = defineValue(initializer);
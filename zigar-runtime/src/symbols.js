@@ -28,6 +28,7 @@ export const ADDRESS = symbol('address');
 export const LENGTH = symbol('length');
 export const LAST_ADDRESS = symbol('last address');
 export const LAST_LENGTH = symbol('last length');
+export const GENERATION = symbol('generation');
 export const CACHE = symbol('cache');
 export const SIZE = symbol('size');
 export const BIT_SIZE = symbol('bit size');
@@ -63,3 +64,4 @@ export const CAST = symbol('cast');
 export const RETURN = symbol('return');
 export const YIELD = symbol('yield');
 export const TRANSFORM = symbol('transform');
+export const SERIALIZE = symbol('serialize');
@@ -1,7 +1,7 @@
 import { VisitorFlag } from '../constants.js';
 import { mixin } from '../environment.js';
 import { ZigMemoryTargetRequired } from '../errors.js';
-import { LAST_ADDRESS, MEMORY, SLOTS, VISIT, VIVIFICATE, ZIG } from '../symbols.js';
+import { GENERATION, LAST_ADDRESS, MEMORY, SLOTS, VISIT, VIVIFICATE, ZIG } from '../symbols.js';
 
 export default mixin({
   defineVisitor() {
@@ -29,6 +29,29 @@ export default mixin({
   },
 });
 
+// incremented whenever a pointer changes its target; each pointer remembers the value from its
+// last change, so that a graph collected earlier can be checked for changes
+let pointerGeneration = 0;
+let conditionalVisitCount = 0;
+
+export function getPointerGeneration() {
+  return pointerGeneration;
+}
+
+export function markPointerChange(pointer) {
+  pointer[GENERATION] = ++pointerGeneration;
+}
+
+export function getConditionalVisitCount() {
+  return conditionalVisitCount;
+}
+
+export function markConditionalVisit() {
+  // the shape of the graph depends on the contents of memory when unions, optionals, and error
+  // unions are involved
+  conditionalVisitCount++;
+}
+
 export function visitChild(slot, cb, flags, src) {
   let child = this[SLOTS][slot];
   if (!child) {
@@ -57,13 +80,16 @@ const builtinVisitors = {
       }
     }
     this[SLOTS][0] = target;
+    markPointerChange(this);
   },
   clear(flags) {
     if (flags & VisitorFlag.IsInactive) {
       this[SLOTS][0] = undefined;
+      markPointerChange(this);
     }
   },
   reset() {
+    // only used on argument structs of inbound calls, which are never part of a cached graph
     this[SLOTS][0] = undefined;
     this[LAST_ADDRESS] = undefined;
   },
@@ -1,12 +1,13 @@
 import { VisitorFlag } from '../constants.js';
 import { mixin } from '../environment.js';
-import { visitChild } from './all.js';
+import { markConditionalVisit, visitChild } from './all.js';
 
 export default mixin({
   defineVisitorOptional(valueMember, getPresent) {
     const { slot } = valueMember;
     return {
       value(cb, flags, src) {
+        markConditionalVisit();
         if (!getPresent.call(this)) {
           flags |= VisitorFlag.IsInactive;
         }
@@ -1,6 +1,6 @@
 import { StructureFlag, VisitorFlag } from '../constants.js';
 import { mixin } from '../environment.js';
-import { visitChild } from './all.js';
+import { markConditionalVisit, visitChild } from './all.js';
 
 export default mixin({
   defineVisitorUnion(members, getSelectorNumber) {
@@ -12,6 +12,7 @@ export default mixin({
     }
     return {
       value(cb, flags, src) {
+        markConditionalVisit();
         const selected = getSelectorNumber?.call(this);
         for (const { index, slot } of pointers) {
           let fieldFlags = flags;
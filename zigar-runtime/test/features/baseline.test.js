@@ -1,6 +1,8 @@
 import { expect } from 'chai';
 import 'mocha-skip-if';
-import { MemberFlag, MemberType, PointerFlag, StructureFlag, StructureType } from '../../src/constants.js';
+import {
+  MemberFlag, MemberType, OptionalFlag, PointerFlag, StructureFlag, StructureType,
+} from '../../src/constants.js';
 import { defineEnvironment } from '../../src/environment.js';
 import '../../src/mixins.js';
 import { copyView, usize, usizeByteSize } from '../../src/utils.js';
@@ -299,6 +301,260 @@ describe('Feature: baseline', function() {
       }
       expect(env.variables).to.have.lengthOf(4);
     })
+    const createStructures = (count) => {
+      const intStructure = {
+        type: StructureType.Primitive,
+        flags: StructureFlag.HasValue,
+        signature: 0x1n,
+        byteSize: 4,
+        align: 4,
+        instance: {
+          members: [
+            {
+              type: MemberType.Int,
+              flags: 0,
+              bitOffset: 0,
+              bitSize: 32,
+              byteSize: 4,
+              structure: {},
+            }
+          ],
+          template: null,
+        },
+        static: {
+          members: [],
+          template: null,
+        },
+      };
+      const structures = [ intStructure ];
+      for (let i = 0; i < count; i++) {
+        structures.push({
+          type: StructureType.Struct,
+          name: `Struct${i}`,
+          flags: 0,
+          signature: BigInt(i + 2),
+          byteSize: 8,
+          align: 4,
+          instance: {
+            members: [
+              {
+                name: 'a',
+                type: MemberType.Int,
+                flags: 0,
+                bitOffset: 0,
+                bitSize: 32,
+                byteSize: 4,
+                structure: intStructure,
+              },
+              {
+                name: 'b',
+                type: MemberType.Int,
+                flags: 0,
+                bitOffset: 32,
+                bitSize: 32,
+                byteSize: 4,
+                structure: intStructure,
+              },
+            ],
+            template: null,
+          },
+          static: {
+            members: [],
+            template: null,
+          },
+        });
+      }
+      return structures;
+    };
+    it('should define structures on first use when lazy is true', function() {
+      const env = new Env();
+      const structures = createStructures(3);
+      env.recreateStructures(structures, {}, true);
+      const isDefined = s => !Object.getOwnPropertyDescriptor(s, 'constructor').get;
+      expect(structures.filter(isDefined)).to.have.lengthOf(0);
+      const { constructor } = structures[2];
+      expect(constructor).to.be.a('function');
+      // the primitive type is not needed until a member is accessed
+      expect(structures.filter(isDefined)).to.have.lengthOf(1);
+      const object = new constructor({ a: 1, b: 2 });
+      expect(object.a).to.equal(1);
+      expect(object.b).to.equal(2);
+      expect(structures[2].constructor).to.equal(constructor);
+    })
+    it('should allow lazy definition to be retried after a failure', function() {
+      const env = new Env();
+      const structures = createStructures(3);
+      env.recreateStructures(structures, {}, true);
+      env.defineStructure = function() {
+        throw new Error('Doh!');
+      };
+      expect(() => structures[2].constructor).to.throw(Error);
+      delete env.defineStructure;
+      const { constructor } = structures[2];
+      expect(constructor).to.be.a('function');
+      const object = new constructor({ a: 1, b: 2 });
+      expect(object.b).to.equal(2);
+    })
+    it('should define self-referential structure on first use when lazy is true', function() {
+      const env = new Env();
+      const addressByteSize = usizeByteSize;
+      const addressSize = addressByteSize * 8;
+      const intStructure = {
+        type: StructureType.Primitive,
+        flags: StructureFlag.HasValue,
+        signature: 0x1n,
+        byteSize: 4,
+        align: 4,
+        instance: {
+          members: [
+            {
+              type: MemberType.Int,
+              flags: 0,
+              bitOffset: 0,
+              bitSize: 32,
+              byteSize: 4,
+              structure: {},
+            }
+          ],
+          template: null,
+        },
+        static: {
+          members: [],
+          template: null,
+        },
+      };
+      const nodeStructure = {
+        type: StructureType.Struct,
+        name: 'Node',
+        flags: StructureFlag.HasPointer | StructureFlag.HasObject | StructureFlag.HasSlot,
+        signature: 0x2n,
+        byteSize: addressByteSize * 2,
+        align: addressByteSize,
+        instance: {
+          members: [
+            {
+              name: 'value',
+              type: MemberType.Int,
+              flags: 0,
+              bitOffset: 0,
+              bitSize: 32,
+              byteSize: 4,
+              structure: intStructure,
+            },
+            {
+              name: 'next',
+              type: MemberType.Object,
+              flags: 0,
+              bitOffset: addressSize,
+              bitSize: addressSize,
+              byteSize: addressByteSize,
+              slot: 0,
+              structure: null,
+            },
+          ],
+          template: null,
+        },
+        static: {
+          members: [],
+          template: null,
+        },
+      };
+      const arrayStructure = {
+        type: StructureType.Array,
+        flags: StructureFlag.HasProxy | StructureFlag.HasPointer | StructureFlag.HasObject | StructureFlag.HasSlot,
+        signature: 0x5n,
+        name: '[1]Node',
+        length: 1,
+        byteSize: addressByteSize * 2,
+        align: addressByteSize,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              flags: 0,
+              bitSize: addressSize * 2,
+              byteSize: addressByteSize * 2,
+              structure: nodeStructure,
+            },
+          ],
+        },
+        static: {
+          members: [],
+          template: null,
+        },
+      };
+      const ptrStructure = {
+        type: StructureType.Pointer,
+        flags: StructureFlag.HasProxy | StructureFlag.HasPointer | StructureFlag.HasObject | StructureFlag.HasSlot
+             | PointerFlag.IsSingle,
+        signature: 0x3n,
+        name: '*[1]Node',
+        byteSize: addressByteSize,
+        align: addressByteSize,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              flags: 0,
+              bitOffset: 0,
+              bitSize: addressSize,
+              byteSize: addressByteSize,
+              slot: 0,
+              structure: arrayStructure,
+            },
+          ],
+          template: null,
+        },
+        static: {
+          members: [],
+          template: null,
+        },
+      };
+      const optStructure = {
+        type: StructureType.Optional,
+        flags: StructureFlag.HasPointer | StructureFlag.HasObject | StructureFlag.HasSlot | StructureFlag.HasValue
+             | OptionalFlag.HasSelector,
+        signature: 0x4n,
+        name: '?*[1]Node',
+        byteSize: addressByteSize,
+        align: addressByteSize,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              flags: 0,
+              bitOffset: 0,
+              bitSize: addressSize,
+              byteSize: addressByteSize,
+              slot: 0,
+              structure: ptrStructure,
+            },
+            {
+              type: MemberType.Bool,
+              flags: MemberFlag.IsSelector,
+              bitOffset: 0,
+              bitSize: 1,
+              byteSize: addressByteSize,
+              structure: {},
+            },
+          ],
+          template: null,
+        },
+        static: {
+          members: [],
+          template: null,
+        },
+      };
+      nodeStructure.instance.members[1].structure = optStructure;
+      const structures = [ intStructure, nodeStructure, arrayStructure, ptrStructure, optStructure ];
+      env.recreateStructures(structures, {}, true);
+      const Node = nodeStructure.constructor;
+      expect(Node).to.be.a('function');
+      expect(arrayStructure.constructor.child).to.equal(Node);
+      const node = new Node({ value: 1, next: [ { value: 2, next: null } ] });
+      expect(node.next[0].value).to.equal(2);
+      expect(node.next[0].next).to.be.null;
+    })
   })
   describe('addListener', function() {
     it('should add listener for log event', function() {
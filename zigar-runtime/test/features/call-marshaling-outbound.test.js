@@ -128,6 +128,110 @@ describe('Feature: call-marshaling-outbound', function() {
       expect(argStruct[0]).to.equal(1);
       expect(argStruct[1]).to.equal(2);
     })
+    it('should create a caller that reuses argument struct when function has only scalar arguments', function() {
+      const env = new Env();
+      const intStructure = {
+        type: StructureType.Primitive,
+        byteSize: 4,
+        flags: StructureFlag.HasValue,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Int,
+              bitSize: 32,
+              bitOffset: 0,
+              byteSize: 4,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(intStructure);
+      env.finishStructure(intStructure);
+      const structure = {
+        type: StructureType.ArgStruct,
+        byteSize: 4 * 3,
+        length: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'retval',
+              type: MemberType.Int,
+              bitSize: 32,
+              bitOffset: 0,
+              byteSize: 4,
+              structure: intStructure,
+            },
+            {
+              name: '0',
+              type: MemberType.Int,
+              bitSize: 32,
+              bitOffset: 32,
+              byteSize: 4,
+              structure: intStructure,
+            },
+            {
+              name: '1',
+              type: MemberType.Int,
+              bitSize: 32,
+              bitOffset: 64,
+              byteSize: 4,
+              structure: intStructure,
+            },
+          ]
+        },
+        static: {},
+      }
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const ArgStruct = structure.constructor;
+      const thunk = {
+        [MEMORY]: new DataView(new ArrayBuffer(0)),
+      };
+      thunk[MEMORY][ZIG] = { address: usize(0x1004) };
+      const self = env.createOutboundCaller(thunk, ArgStruct, structure);
+      self[MEMORY] = new DataView(new ArrayBuffer(0));
+      self[MEMORY][ZIG] = { address: usize(0x2008) };
+      let allocationCount = 0;
+      env.allocateScratchMemory = function(len, align) {
+        allocationCount++;
+        return usize(0x4000);
+      };
+      const bufferMap = new Map();
+      if (process.env.TARGET === 'wasm') {
+        env.memory = new WebAssembly.Memory({ initial: 128 });
+      } else if (process.env.TARGET === 'node') {
+        let nextAddress = usize(0xf000_1000);
+        env.getBufferAddress = function(buffer) {
+          allocationCount++;
+          const address = nextAddress;
+          nextAddress += usize(0x1000);
+          bufferMap.set(address, buffer);
+          return address;
+        }
+      }
+      let flushCount = 0;
+      env.flushStreams = () => flushCount++;
+      const addresses = [];
+      env.runThunk = (thunkAddress, fnAddress, argAddress) => {
+        addresses.push(argAddress);
+        const argDV = (process.env.TARGET === 'wasm')
+        ? new DataView(env.memory.buffer, argAddress, 12)
+        : new DataView(bufferMap.get(argAddress));
+        argDV.setInt32(0, argDV.getInt32(4, true) + argDV.getInt32(8, true), true);
+        return true;
+      };
+      expect(self(1, 2)).to.equal(3);
+      expect(self(3, 4)).to.equal(7);
+      // output without a trailing newline should show up right away
+      expect(flushCount).to.equal(2);
+      expect(addresses[0]).to.equal(addresses[1]);
+      expect(allocationCount).to.equal(1);
+      expect(() => self(1)).to.throw();
+    })
     if (process.env.TARGET === 'wasm') {
       it('should return promise when thunk runner is not ready', async function() {
         const env = new Env();
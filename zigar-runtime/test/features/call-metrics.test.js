@@ -0,0 +1,187 @@
+import { expect } from 'chai';
+import { MemberType, StructureFlag, StructureType } from '../../src/constants.js';
+import { defineEnvironment } from '../../src/environment.js';
+import '../../src/mixins.js';
+import { MEMORY, ZIG } from '../../src/symbols.js';
+import { usize } from '../../src/utils.js';
+
+const Env = defineEnvironment();
+
+describe('Feature: call-metrics', function() {
+  describe('enableMetrics', function() {
+    it('should start gathering metrics', function() {
+      const env = new Env();
+      expect(env.getMetrics()).to.be.null;
+      env.enableMetrics();
+      const metrics = env.getMetrics();
+      expect(metrics.functions).to.eql([]);
+      expect(metrics.shadowCopy).to.eql({ bytesIn: 0, bytesOut: 0 });
+      expect(metrics.crossThread).to.eql({ callbacks: 0, syscalls: 0 });
+      expect(metrics.latencyBuckets.at(-1)).to.equal(Infinity);
+    })
+    it('should throw when interval is given without a callback', function() {
+      const env = new Env();
+      expect(() => env.enableMetrics({ interval: 100 })).to.throw(TypeError);
+    })
+    it('should send snapshots periodically', async function() {
+      const env = new Env();
+      const snapshots = [];
+      env.enableMetrics({ interval: 10, onReport: (s) => snapshots.push(s) });
+      try {
+        env.recordCall(function hello() {}, performance.now(), null);
+        await new Promise(r => setTimeout(r, 35));
+      } finally {
+        env.disableMetrics();
+      }
+      expect(snapshots.length).to.be.at.least(2);
+      expect(snapshots[0].functions[0]).to.include({ name: 'hello', count: 1 });
+      // counters are reset after each report by default
+      expect(snapshots[1].functions).to.eql([]);
+    })
+  })
+  describe('disableMetrics', function() {
+    it('should stop gathering metrics', function() {
+      const env = new Env();
+      env.enableMetrics();
+      env.disableMetrics();
+      expect(env.getMetrics()).to.be.null;
+      // call in progress should not cause an error
+      env.recordCall(function hello() {}, performance.now(), null);
+    })
+  })
+  describe('getMetrics', function() {
+    it('should reset counters when asked', function() {
+      const env = new Env();
+      env.enableMetrics();
+      env.recordCall(function hello() {}, performance.now(), null);
+      expect(env.getMetrics(true).functions).to.have.lengthOf(1);
+      expect(env.getMetrics().functions).to.have.lengthOf(0);
+    })
+  })
+  describe('recordCall', function() {
+    it('should place call into latency bucket', function() {
+      const env = new Env();
+      env.enableMetrics();
+      const fn = function hello() {};
+      env.recordCall(fn, performance.now() - 3, { bytesCopied: 16 });
+      env.recordCall(fn, performance.now() - 1000, { bytesCopied: 8 });
+      const { functions: [ entry ], latencyBuckets } = env.getMetrics();
+      expect(entry.count).to.equal(2);
+      expect(entry.bytesCopied).to.equal(24);
+      expect(entry.maxTime).to.be.at.least(1000);
+      expect(entry.totalTime).to.be.at.least(1003);
+      expect(entry.histogram[latencyBuckets.indexOf(5000)]).to.equal(1);
+      expect(entry.histogram[latencyBuckets.length - 1]).to.equal(1);
+    })
+  })
+  describe('recordShadowCopy', function() {
+    it('should add bytes copied by updateShadows and updateShadowTargets', function() {
+      const env = new Env();
+      env.enableMetrics();
+      const targetDV = new DataView(new ArrayBuffer(32));
+      const shadowDV = new DataView(new ArrayBuffer(32));
+      if (process.env.TARGET === 'wasm') {
+        env.restoreView = (dv) => dv;
+      }
+      const context = {
+        shadowList: [
+          { targetDV, shadowDV, writable: true },
+          { targetDV: new DataView(targetDV.buffer, 0, 8), shadowDV: new DataView(shadowDV.buffer, 0, 8), writable: false },
+        ],
+      };
+      env.updateShadows(context);
+      env.updateShadowTargets(context);
+      expect(env.getMetrics().shadowCopy).to.eql({ bytesIn: 40, bytesOut: 32 });
+      expect(context.bytesCopied).to.equal(72);
+    })
+  })
+  describe('recordThreadCrossing', function() {
+    it('should distinguish callbacks from syscalls', function() {
+      const env = new Env();
+      env.enableMetrics();
+      env.recordThreadCrossing('handleJscall');
+      env.recordThreadCrossing('_handleJscall');
+      env.recordThreadCrossing('fdWrite');
+      expect(env.getMetrics().crossThread).to.eql({ callbacks: 2, syscalls: 1 });
+    })
+    if (process.env.TARGET === 'node') {
+      it('should be called when a function is invoked from another thread', function() {
+        const env = new Env();
+        env.enableMetrics();
+        env.finalizeAsyncCall = () => {};
+        const fn = env.addPromiseHandling(function(a, canWait) { return 0 }, 'fdWrite');
+        fn.call(env, 1, 0);
+        fn.call(env, 1, 1234);
+        expect(env.getMetrics().crossThread).to.eql({ callbacks: 0, syscalls: 1 });
+      })
+    }
+  })
+  describe('invokeThunk', function() {
+    it('should record calls made through outbound caller', function() {
+      const env = new Env();
+      const intStructure = {
+        type: StructureType.Primitive,
+        byteSize: 4,
+        flags: StructureFlag.HasValue,
+        signature: 0n,
+        instance: {
+          members: [
+            { type: MemberType.Int, bitSize: 32, bitOffset: 0, byteSize: 4, structure: {} },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(intStructure);
+      env.finishStructure(intStructure);
+      const structure = {
+        type: StructureType.ArgStruct,
+        byteSize: 4 * 3,
+        length: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            { name: 'retval', type: MemberType.Int, bitSize: 32, bitOffset: 0, byteSize: 4, structure: intStructure },
+            { name: '0', type: MemberType.Int, bitSize: 32, bitOffset: 32, byteSize: 4, structure: intStructure },
+            { name: '1', type: MemberType.Int, bitSize: 32, bitOffset: 64, byteSize: 4, structure: intStructure },
+          ]
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const thunk = { [MEMORY]: new DataView(new ArrayBuffer(0)) };
+      thunk[MEMORY][ZIG] = { address: usize(0x1004) };
+      const add = env.createOutboundCaller(thunk, structure.constructor);
+      add[MEMORY] = new DataView(new ArrayBuffer(0));
+      add[MEMORY][ZIG] = { address: usize(0x2008) };
+      env.runThunk = () => true;
+      env.allocateScratchMemory = () => usize(0x4000);
+      env.freeScratchMemory = () => {};
+      if (process.env.TARGET === 'wasm') {
+        env.memory = new WebAssembly.Memory({ initial: 128 });
+      } else if (process.env.TARGET === 'node') {
+        let nextAddress = usize(0xf000_1000);
+        const addressMap = new Map();
+        env.getBufferAddress = function(buffer) {
+          let address = addressMap.get(buffer);
+          if (!address) {
+            address = nextAddress;
+            nextAddress += usize(0x1000);
+            addressMap.set(buffer, address);
+          }
+          return address;
+        };
+      }
+      Object.defineProperty(add, 'name', { value: 'add' });
+      add(1, 2);
+      env.enableMetrics();
+      for (let i = 0; i < 5; i++) {
+        add(i, 2);
+      }
+      const { functions } = env.getMetrics();
+      expect(functions).to.have.lengthOf(1);
+      expect(functions[0]).to.include({ name: 'add', count: 5 });
+      expect(functions[0].histogram.reduce((t, n) => t + n)).to.equal(5);
+    })
+  })
+})
@@ -561,6 +561,48 @@ describe('Feature: memory-mapping', function() {
         expect(() => env.allocateShadowMemory(16, 4)).to.throw();
       })
     })
+    describe('allocateContextMemory', function() {
+      it('should carve memory from arena reserved for context', function() {
+        const env = new Env();
+        env.memory = new WebAssembly.Memory({ initial: 1 });
+        let allocCount = 0;
+        env.allocateScratchMemory = function(len, align) {
+          allocCount++;
+          return 0x1000;
+        };
+        const freed = [];
+        env.freeScratchMemory = function(address, len, align) {
+          freed.push(address);
+        };
+        const context = env.startContext();
+        env.reserveShadowMemory(context, 64);
+        const dv1 = env.allocateContextMemory(context, 3, 1);
+        const dv2 = env.allocateContextMemory(context, 8, 8);
+        expect(env.getViewAddress(dv1)).to.equal(0x1000);
+        expect(env.getViewAddress(dv2)).to.equal(0x1008);
+        expect(dv2.byteOffset).to.equal(0x1008);
+        expect(allocCount).to.equal(1);
+        env.registerMemory(0x1000, 3, 1, true, new DataView(new ArrayBuffer(3)), dv1);
+        env.registerMemory(0x1008, 8, 8, true, new DataView(new ArrayBuffer(8)), dv2);
+        env.endContext();
+        // only the arena itself should be freed
+        expect(freed).to.eql([ 0x1000 ]);
+      })
+      it('should allocate memory separately when arena is exhausted', function() {
+        const env = new Env();
+        env.memory = new WebAssembly.Memory({ initial: 1 });
+        const addresses = [ 0x1000, 0x2000 ];
+        env.allocateScratchMemory = function(len, align) {
+          return addresses.shift();
+        };
+        const context = env.startContext();
+        env.reserveShadowMemory(context, 16);
+        const dv1 = env.allocateContextMemory(context, 16, 4);
+        const dv2 = env.allocateContextMemory(context, 4, 4);
+        expect(env.getViewAddress(dv1)).to.equal(0x1000);
+        expect(env.getViewAddress(dv2)).to.equal(0x2000);
+      })
+    })
     describe('getBufferAddress', function() {
       it('should return zero', function() {
         const env = new Env();
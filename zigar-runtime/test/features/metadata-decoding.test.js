@@ -0,0 +1,50 @@
+import { expect } from 'chai';
+import { MetadataTag, metadataMagic } from '../../src/constants.js';
+import { defineEnvironment } from '../../src/environment.js';
+import '../../src/mixins.js';
+
+const Env = defineEnvironment();
+
+describe('Feature: metadata-decoding', function() {
+  describe('decodeStructures', function() {
+    const encode = (bytes) => Buffer.from(bytes).toString('base64');
+    it('should decode structures, objects, and settings', function() {
+      const bytes = [
+        ...metadataMagic,
+        // strings
+        3, 4, ...Buffer.from('name'), 9, ...Buffer.from('signature'), 4, ...Buffer.from('self'),
+        // buffers
+        1, 2, 0xff, 0x01,
+        // structure and object count
+        1, 1,
+        // structure
+        MetadataTag.Record, 3,
+          0, MetadataTag.String, 0,
+          1, MetadataTag.BigInt, 0x81, 0x01,
+          2, MetadataTag.StructureRef, 0,
+        // object
+        MetadataTag.Record, 1,
+          2, MetadataTag.BufferRef, 0,
+        // settings
+        MetadataTag.Record, 2,
+          0, MetadataTag.NegativeInt, 5,
+          1, MetadataTag.NegativeBigInt, 0x81, 0x01,
+        // root
+        0,
+      ];
+      const env = new Env();
+      const { structures, root, settings } = env.decodeStructures(encode(bytes));
+      expect(structures).to.have.lengthOf(1);
+      expect(root).to.equal(structures[0]);
+      expect(root.constructor).to.be.null;
+      expect(root.name).to.equal('name');
+      expect(root.signature).to.equal(129n);
+      expect(root.self).to.equal(root);
+      expect(settings).to.eql({ name: -5, signature: -129n });
+    })
+    it('should throw when data is not structure metadata', function() {
+      const env = new Env();
+      expect(() => env.decodeStructures(encode([ 1, 2, 3, 4 ]))).to.throw();
+    })
+  })
+})
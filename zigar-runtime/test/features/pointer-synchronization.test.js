@@ -770,6 +770,110 @@ describe('Feature: pointer-synchronization', function() {
       expect(called).to.be.false;
     })
   })
+  describe('getPointerGraph', function() {
+    it('should return cached pointer graph until a pointer changes', function() {
+      const env = new Env();
+      const intStructure = {
+        type: StructureType.Primitive,
+        flags: StructureFlag.HasValue,
+        byteSize: 4,
+        align: 4,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Uint,
+              bitSize: 32,
+              bitOffset: 0,
+              byteSize: 4,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(intStructure);
+      env.finishStructure(intStructure);
+      const Int32 = intStructure.constructor;
+      const ptrStructure = {
+        type: StructureType.Pointer,
+        flags: StructureFlag.HasPointer | StructureFlag.HasObject | StructureFlag.HasSlot | PointerFlag.IsSingle,
+        name: '*i32',
+        byteSize: addressByteSize,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: addressSize,
+              bitOffset: 0,
+              byteSize: addressByteSize,
+              slot: 0,
+              structure: intStructure,
+            },
+            {
+              type: MemberType.Uint,
+              bitSize: addressSize,
+              bitOffset: 0,
+              byteSize: addressByteSize,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(ptrStructure);
+      env.finishStructure(ptrStructure);
+      const structure = {
+        type: StructureType.Struct,
+        flags: StructureFlag.HasPointer | StructureFlag.HasObject | StructureFlag.HasSlot,
+        byteSize: addressByteSize * 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'a',
+              type: MemberType.Object,
+              bitOffset: 0,
+              bitSize: addressSize,
+              byteSize: addressByteSize,
+              slot: 0,
+              structure: ptrStructure,
+            },
+            {
+              name: 'b',
+              type: MemberType.Object,
+              bitOffset: addressSize,
+              bitSize: addressSize,
+              byteSize: addressByteSize,
+              slot: 1,
+              structure: ptrStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const Hello = structure.constructor;
+      const object = new Hello({ a: new Int32(123), b: new Int32(456) });
+      // not collected on first sighting
+      expect(env.getPointerGraph(object)).to.be.null;
+      const graph1 = env.getPointerGraph(object);
+      expect(graph1).to.be.an('array').with.lengthOf(2);
+      expect(graph1[0].target).to.equal(object.a['*']);
+      const graph2 = env.getPointerGraph(object);
+      expect(graph2).to.equal(graph1);
+      // a change to an unrelated pointer should not invalidate the graph
+      new Hello({ a: new Int32(1), b: new Int32(2) });
+      expect(env.getPointerGraph(object)).to.equal(graph1);
+      object.b = new Int32(789);
+      expect(env.getPointerGraph(object)).to.be.null;
+      const graph3 = env.getPointerGraph(object);
+      expect(graph3).to.not.equal(graph1);
+      expect(graph3[1].target).to.equal(object.b['*']);
+    })
+  })
   describe('findTargetClusters', function() {
     it('should find overlapping objects', function() {
       const env = new Env();
@@ -76,6 +76,39 @@ if (process.env.TARGET === 'wasm') {
         expect(freedFnId1).to.equal(fnId);
         expect(freedFnId2).to.equal(fnId + 1);
       })
+      it('should reuse table slot and thunk of freed thunk', async function() {
+        const wasmPath = absolute('./wasm-samples/fn-pointer.wasm');
+        const binary = await readFile(wasmPath);
+        const env = new Env();
+        await env.loadModule(binary, {
+          tableInitial: 100,
+          multithreaded: false,
+        });
+        env.acquireStructures();
+        const { Fn } = env.useStructures();
+        let thunkControllerAddress;
+        let fnId;
+        env.createJsThunk = function(address, id) {
+          thunkControllerAddress = address;
+          fnId = id;
+          return usize(100);
+        };
+        new Fn(() => {});
+        const thunkAddresses = [];
+        for (let i = 0; i < 1000; i++) {
+          thunkAddresses.push(env.allocateJsThunk(thunkControllerAddress, fnId + i));
+        }
+        const sourceCount = env.thunkSources.length;
+        const tableLength = env.table.length;
+        for (const thunkAddress of thunkAddresses) {
+          env.freeJsThunk(thunkControllerAddress, thunkAddress);
+        }
+        for (let i = 0; i < 1000; i++) {
+          env.allocateJsThunk(thunkControllerAddress, fnId + i);
+        }
+        expect(env.thunkSources).to.have.lengthOf(sourceCount);
+        expect(env.table.length).to.equal(tableLength);
+      })
     })
     describe('findJsThunk', function() {
       it('should find the id of a thunk by address', async function() {
@@ -103,6 +136,8 @@ if (process.env.TARGET === 'wasm') {
         const foundFnId2 = env.findJsThunk(thunkControllerAddress, thunkAddress2);
         expect(foundFnId1).to.equal(fnId);
         expect(foundFnId2).to.equal(fnId + 1);
+        // thunk should still be there
+        expect(env.findJsThunk(thunkControllerAddress, thunkAddress1)).to.equal(fnId);
       })
     })
   })
@@ -28,6 +28,46 @@ if (process.env.TARGET === 'wasm') {
         });
         expect(line).to.equal('Hello!');
       })
+      it('should reuse idle worker from pool', async function() {
+        const env = new Env();
+        const url = new URL('./wasm-samples/thread.wasm', import.meta.url);
+        const buffer = await readFile(fileURLToPath(url));
+        await env.loadModule(buffer, {
+          memoryInitial: 256,
+          memoryMax: 1024,
+          tableInitial: 17,
+          multithreaded: true,
+          workerPoolSize: 1,
+        });
+        expect(env.idleWorkers).to.have.lengthOf(1);
+        env.acquireStructures();
+        const { spawn } = env.useStructures();
+        await capture(async () => {
+          spawn();
+          await delay(500);
+          spawn();
+          await delay(500);
+        });
+        const stats = env.getWorkerStatistics();
+        expect(stats.spawns).to.equal(2);
+        expect(stats.poolHits).to.equal(2);
+        expect(stats.hitRate).to.equal(1);
+        expect(stats.maxSpawnLatency).to.be.at.least(0);
+        expect(env.idleWorkers).to.have.lengthOf(1);
+        env.abandonModule();
+        expect(env.idleWorkers).to.have.lengthOf(0);
+      })
+    })
+    describe('getWorkerStatistics', function() {
+      it('should average latency over spawns that reported it', function() {
+        const env = new Env();
+        env.workerStats.spawns = 3;
+        env.recordSpawnLatency(4);
+        env.recordSpawnLatency(2);
+        const stats = env.getWorkerStatistics();
+        expect(stats.averageSpawnLatency).to.equal(3);
+        expect(stats.maxSpawnLatency).to.equal(4);
+      })
     })
   })
 }
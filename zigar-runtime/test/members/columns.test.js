@@ -0,0 +1,969 @@
+import { expect } from 'chai';
+import { MemberType, StructFlag, StructureFlag, StructureType } from '../../src/constants.js';
+import { defineEnvironment } from '../../src/environment.js';
+import '../../src/mixins.js';
+
+const Env = defineEnvironment();
+
+describe('Member: columns', function() {
+  describe('getColumns', function() {
+    it('should return numeric fields of struct', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'y',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 32,
+              bitOffset: 128,
+              byteSize: 4,
+              structure: {},
+            },
+            {
+              name: 'flag',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 160,
+              byteSize: 1,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        instance: { members: [ { type: MemberType.Object, byteSize: 24, structure: structStructure } ] },
+      };
+      const columns = env.getColumns(structure);
+      expect(columns.map(c => c.name)).to.eql([ 'x', 'y', 'id', 'flag' ]);
+      expect(columns.map(c => c.direct)).to.eql([ true, true, true, false ]);
+    })
+    it('should return empty list when elements are not structs', function() {
+      const env = new Env();
+      const structure = {
+        type: StructureType.Slice,
+        instance: { members: [ { type: MemberType.Uint, bitSize: 32, byteSize: 4, structure: { type: StructureType.Primitive } } ] },
+      };
+      const columns = env.getColumns(structure);
+      expect(columns).to.eql([]);
+    })
+  })
+  describe('defineColumns', function() {
+    it('should not define methods when there are no columns', function() {
+      const env = new Env();
+      const structure = {
+        type: StructureType.Slice,
+        instance: { members: [ { type: MemberType.Uint, bitSize: 32, byteSize: 4, structure: { type: StructureType.Primitive } } ] },
+      };
+      const { toColumns, fromColumns } = env.defineColumns(structure);
+      expect(toColumns).to.be.undefined;
+      expect(fromColumns).to.be.undefined;
+    })
+  })
+  describe('toColumns', function() {
+    it('should extract fields of extern struct into typed arrays', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'y',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 32,
+              bitOffset: 128,
+              byteSize: 4,
+              structure: {},
+            },
+            {
+              name: 'flag',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 160,
+              byteSize: 1,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 192,
+              byteSize: 24,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(4);
+      for (let i = 0; i < 4; i++) {
+        slice[i] = { x: i * 1.5, y: -i, id: i * 10, flag: i % 2 === 0 };
+      }
+      const { x, y, id, flag } = slice.toColumns();
+      expect(x).to.be.an.instanceOf(Float64Array);
+      expect([ ...x ]).to.eql([ 0, 1.5, 3, 4.5 ]);
+      expect([ ...y ]).to.eql([ -0, -1, -2, -3 ]);
+      expect(id).to.be.an.instanceOf(Uint32Array);
+      expect([ ...id ]).to.eql([ 0, 10, 20, 30 ]);
+      expect(flag).to.be.an.instanceOf(Uint8Array);
+      expect([ ...flag ]).to.eql([ 1, 0, 1, 0 ]);
+    })
+    it('should extract fields of packed struct into typed arrays', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsPacked,
+        name: 'Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'a',
+              type: MemberType.Uint,
+              bitSize: 3,
+              bitOffset: 0,
+              structure: {},
+            },
+            {
+              name: 'b',
+              type: MemberType.Int,
+              bitSize: 5,
+              bitOffset: 3,
+              structure: {},
+            },
+            {
+              name: 'c',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 8,
+              structure: {},
+            },
+            {
+              name: 'd',
+              type: MemberType.Uint,
+              bitSize: 7,
+              bitOffset: 9,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 16,
+              byteSize: 2,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PackedSlice } = structure;
+      const slice = new PackedSlice(4);
+      for (let i = 0; i < 4; i++) {
+        slice[i] = { a: i, b: -i, c: i % 2 === 1, d: 100 + i };
+      }
+      const { a, b, c, d } = slice.toColumns();
+      expect([ ...a ]).to.eql([ 0, 1, 2, 3 ]);
+      expect(b).to.be.an.instanceOf(Int8Array);
+      expect([ ...b ]).to.eql([ 0, -1, -2, -3 ]);
+      expect([ ...c ]).to.eql([ 0, 1, 0, 1 ]);
+      expect([ ...d ]).to.eql([ 100, 101, 102, 103 ]);
+    })
+    it('should return empty typed arrays when slice is empty', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 128,
+              byteSize: 16,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(0);
+      const { x, id } = slice.toColumns();
+      expect(x).to.be.an.instanceOf(Float64Array);
+      expect(x).to.have.lengthOf(0);
+      expect(id).to.be.an.instanceOf(BigUint64Array);
+      expect(id).to.have.lengthOf(0);
+    })
+  })
+  describe('fromColumns', function() {
+    it('should fill extern structs from typed arrays', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'y',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 32,
+              bitOffset: 128,
+              byteSize: 4,
+              structure: {},
+            },
+            {
+              name: 'flag',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 160,
+              byteSize: 1,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 192,
+              byteSize: 24,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(3);
+      const result = slice.fromColumns({
+        x: new Float64Array([ 1, 2, 3 ]),
+        id: new Uint32Array([ 7, 8, 9 ]),
+        flag: new Uint8Array([ 0, 1, 1 ]),
+      });
+      expect(result).to.equal(slice);
+      expect(slice.valueOf()).to.eql([
+        { x: 1, y: 0, id: 7, flag: false },
+        { x: 2, y: 0, id: 8, flag: true },
+        { x: 3, y: 0, id: 9, flag: true },
+      ]);
+    })
+    it('should fill packed structs from typed arrays', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsPacked,
+        name: 'Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'a',
+              type: MemberType.Uint,
+              bitSize: 3,
+              bitOffset: 0,
+              structure: {},
+            },
+            {
+              name: 'b',
+              type: MemberType.Int,
+              bitSize: 5,
+              bitOffset: 3,
+              structure: {},
+            },
+            {
+              name: 'c',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 8,
+              structure: {},
+            },
+            {
+              name: 'd',
+              type: MemberType.Uint,
+              bitSize: 7,
+              bitOffset: 9,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 16,
+              byteSize: 2,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PackedSlice } = structure;
+      const slice = new PackedSlice(2);
+      slice.fromColumns({
+        a: new Uint8Array([ 5, 7 ]),
+        b: new Int8Array([ -16, 15 ]),
+        c: new Uint8Array([ 1, 0 ]),
+        d: new Uint8Array([ 127, 1 ]),
+      });
+      expect(slice.valueOf()).to.eql([
+        { a: 5, b: -16, c: true, d: 127 },
+        { a: 7, b: 15, c: false, d: 1 },
+      ]);
+    })
+    it('should throw when column length does not match', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'y',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 32,
+              bitOffset: 128,
+              byteSize: 4,
+              structure: {},
+            },
+            {
+              name: 'flag',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 160,
+              byteSize: 1,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 192,
+              byteSize: 24,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(3);
+      expect(() => slice.fromColumns({ x: new Float64Array(2) })).to.throw(TypeError);
+    })
+    it('should throw when there is no field with the name', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'y',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 32,
+              bitOffset: 128,
+              byteSize: 4,
+              structure: {},
+            },
+            {
+              name: 'flag',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 160,
+              byteSize: 1,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 192,
+              byteSize: 24,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(3);
+      expect(() => slice.fromColumns({ z: new Float64Array(3) })).to.throw(TypeError)
+        .with.property('message').that.contains('z');
+    })
+    it('should throw when value of aligned field is out of range and runtime safety is on', function() {
+      const env = new Env();
+      env.runtimeSafety = true;
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'y',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 32,
+              bitOffset: 128,
+              byteSize: 4,
+              structure: {},
+            },
+            {
+              name: 'flag',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 160,
+              byteSize: 1,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 24,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 192,
+              byteSize: 24,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(2);
+      expect(() => slice.fromColumns({ id: [ 1, -1 ] })).to.throw(TypeError)
+        .with.property('message').that.contains('-1');
+      expect(() => slice.fromColumns({ id: new Float64Array([ 1, 2 ** 32 ]) })).to.throw(TypeError);
+      expect(() => slice.fromColumns({ id: new Uint32Array([ 1, 2 ]) })).to.not.throw();
+    })
+    it('should throw when value of bit field is out of range and runtime safety is on', function() {
+      const env = new Env();
+      env.runtimeSafety = true;
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsPacked,
+        name: 'Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'a',
+              type: MemberType.Uint,
+              bitSize: 3,
+              bitOffset: 0,
+              structure: {},
+            },
+            {
+              name: 'b',
+              type: MemberType.Int,
+              bitSize: 5,
+              bitOffset: 3,
+              structure: {},
+            },
+            {
+              name: 'c',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 8,
+              structure: {},
+            },
+            {
+              name: 'd',
+              type: MemberType.Uint,
+              bitSize: 7,
+              bitOffset: 9,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 16,
+              byteSize: 2,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PackedSlice } = structure;
+      const slice = new PackedSlice(2);
+      expect(() => slice.fromColumns({ a: new Uint8Array([ 1, 8 ]) })).to.throw(TypeError);
+      expect(() => slice.fromColumns({ b: new Int8Array([ -17, 0 ]) })).to.throw(TypeError);
+      expect(() => slice.fromColumns({ b: new Int8Array([ -16, 15 ]) })).to.not.throw();
+    })
+    it('should not check range when runtime safety is off', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsPacked,
+        name: 'Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'a',
+              type: MemberType.Uint,
+              bitSize: 3,
+              bitOffset: 0,
+              structure: {},
+            },
+            {
+              name: 'b',
+              type: MemberType.Int,
+              bitSize: 5,
+              bitOffset: 3,
+              structure: {},
+            },
+            {
+              name: 'c',
+              type: MemberType.Bool,
+              bitSize: 1,
+              bitOffset: 8,
+              structure: {},
+            },
+            {
+              name: 'd',
+              type: MemberType.Uint,
+              bitSize: 7,
+              bitOffset: 9,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Packed',
+        byteSize: 2,
+        align: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 16,
+              byteSize: 2,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PackedSlice } = structure;
+      const slice = new PackedSlice(1);
+      expect(() => slice.fromColumns({ a: new Uint8Array([ 8 ]) })).to.not.throw();
+    })
+    it('should accept empty columns when slice is empty', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 128,
+              byteSize: 16,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(0);
+      expect(() => slice.fromColumns({ x: new Float64Array(0), id: [] })).to.not.throw();
+    })
+    it('should convert numbers when filling 64-bit integer fields', function() {
+      const env = new Env();
+      const structStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsExtern,
+        name: 'Point',
+        byteSize: 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'x',
+              type: MemberType.Float,
+              bitSize: 64,
+              bitOffset: 0,
+              byteSize: 8,
+              structure: {},
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 64,
+              bitOffset: 64,
+              byteSize: 8,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structStructure);
+      env.finishStructure(structStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Point',
+        byteSize: 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 128,
+              byteSize: 16,
+              structure: structStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: PointSlice } = structure;
+      const slice = new PointSlice(3);
+      slice.fromColumns({ x: [ 1, 2, 3 ], id: [ 10, 20, 30 ] });
+      expect(slice[1].id).to.equal(20n);
+      slice.fromColumns({ id: new BigUint64Array([ 40n, 50n, 60n ]) });
+      expect(slice[2].id).to.equal(60n);
+    })
+  })
+})
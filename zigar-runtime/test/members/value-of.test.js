@@ -1,6 +1,7 @@
 import { expect } from 'chai';
-import { MemberType, StructureFlag, StructureType, UnionFlag } from '../../src/constants.js';
+import { MemberType, StructFlag, StructureFlag, StructureType, UnionFlag } from '../../src/constants.js';
 import { defineEnvironment } from '../../src/environment.js';
+import { normalizeObject } from '../../src/members/value-of.js';
 import '../../src/mixins.js';
 import { addressByteSize, addressSize } from '../test-utils.js';
 
@@ -219,4 +220,245 @@ describe('Member: valueOf', function() {
       expect(object.valueOf().goat).to.be.a('symbol');
     })
   })
+  describe('defineSerializer', function() {
+    it('should not create serializer for structure with pointers', function() {
+      const env = new Env();
+      const structure = {
+        type: StructureType.Struct,
+        flags: StructureFlag.HasPointer,
+        instance: { members: [] },
+      };
+      expect(env.createSerializer(structure, false)).to.be.null;
+    })
+    it('should not create serializer when struct contains enum', function() {
+      const env = new Env();
+      const structure = {
+        type: StructureType.Struct,
+        flags: 0,
+        instance: {
+          members: [
+            {
+              name: 'pet',
+              type: MemberType.Uint,
+              bitSize: 8,
+              byteSize: 1,
+              bitOffset: 0,
+              structure: { type: StructureType.Enum },
+            },
+          ],
+        },
+      };
+      expect(env.createSerializer(structure, false)).to.be.null;
+    })
+    it('should produce the same results as generic code', function() {
+      const env = new Env();
+      const wideStructure = {
+        type: StructureType.Struct,
+        flags: 0,
+        name: 'Wide',
+        byteSize: 32,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'float',
+              type: MemberType.Float,
+              bitSize: 64,
+              byteSize: 8,
+              bitOffset: 0,
+              structure: {},
+            },
+            {
+              name: 'int',
+              type: MemberType.Int,
+              bitSize: 32,
+              byteSize: 4,
+              bitOffset: 64,
+              structure: {},
+            },
+            {
+              name: 'uint',
+              type: MemberType.Uint,
+              bitSize: 64,
+              byteSize: 8,
+              bitOffset: 128,
+              structure: {},
+            },
+            {
+              name: 'bool',
+              type: MemberType.Bool,
+              bitSize: 1,
+              byteSize: 1,
+              bitOffset: 192,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(wideStructure);
+      env.finishStructure(wideStructure);
+      const arrayStructure = {
+        type: StructureType.Array,
+        flags: StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[4]Wide',
+        length: 4,
+        byteSize: 32 * 4,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: 32 * 8,
+              byteSize: 32,
+              structure: wideStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(arrayStructure);
+      env.finishStructure(arrayStructure);
+      const vectorStructure = {
+        type: StructureType.Vector,
+        flags: 0,
+        name: '@Vector(4, bool)',
+        length: 4,
+        byteSize: 1,
+        align: 1,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Bool,
+              bitSize: 1,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(vectorStructure);
+      env.finishStructure(vectorStructure);
+      const deepStructure = {
+        type: StructureType.Struct,
+        flags: StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: 'Deep',
+        byteSize: 32 * 4 + 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              name: 'items',
+              type: MemberType.Object,
+              bitSize: 32 * 4 * 8,
+              byteSize: 32 * 4,
+              bitOffset: 0,
+              slot: 0,
+              structure: arrayStructure,
+            },
+            {
+              name: 'flags',
+              type: MemberType.Object,
+              bitSize: 8,
+              byteSize: 1,
+              bitOffset: 32 * 4 * 8,
+              slot: 1,
+              structure: vectorStructure,
+            },
+            {
+              name: 'id',
+              type: MemberType.Uint,
+              bitSize: 64,
+              byteSize: 8,
+              bitOffset: 32 * 4 * 8 + 64,
+              structure: {},
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(deepStructure);
+      env.finishStructure(deepStructure);
+      const structure = {
+        type: StructureType.Slice,
+        flags: StructureFlag.HasProxy | StructureFlag.HasObject | StructureFlag.HasSlot,
+        name: '[]Deep',
+        byteSize: 32 * 4 + 16,
+        align: 8,
+        signature: 0n,
+        instance: {
+          members: [
+            {
+              type: MemberType.Object,
+              bitSize: (32 * 4 + 16) * 8,
+              byteSize: 32 * 4 + 16,
+              structure: deepStructure,
+            },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: DeepSlice } = structure;
+      const slice = new DeepSlice(8);
+      for (let i = 0; i < 8; i++) {
+        const item = { float: i + 0.5, int: -i, uint: BigInt(i * 3), bool: i % 2 === 0 };
+        slice[i] = { items: [ item, item, item, item ], flags: [ true, false, i % 2 === 0, true ], id: BigInt(i) };
+      }
+      expect(slice.valueOf()).to.eql(normalizeObject(slice, false, false));
+      expect(slice.toJSON()).to.eql(normalizeObject(slice, true, false));
+      expect(slice[3].valueOf()).to.eql(normalizeObject(slice[3], false, false));
+      expect(slice.valueOf()[3].flags).to.eql([ true, false, false, true ]);
+      expect(slice.valueOf()[3].id).to.equal(3n);
+      expect(slice.toJSON()[3].id).to.equal(3);
+    })
+    it('should handle packed struct and tuple', function() {
+      const env = new Env();
+      const packedStructure = {
+        type: StructureType.Struct,
+        flags: StructFlag.IsPacked,
+        name: 'Packed',
+        byteSize: 1,
+        align: 1,
+        signature: 0n,
+        instance: {
+          members: [
+            { name: 'a', type: MemberType.Uint, bitSize: 3, bitOffset: 0, structure: {} },
+            { name: 'b', type: MemberType.Bool, bitSize: 1, bitOffset: 3, structure: {} },
+            { name: 'c', type: MemberType.Int, bitSize: 4, bitOffset: 4, structure: {} },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(packedStructure);
+      env.finishStructure(packedStructure);
+      const structure = {
+        type: StructureType.Struct,
+        flags: StructureFlag.HasObject | StructureFlag.HasSlot | StructFlag.IsTuple,
+        name: 'Tuple',
+        byteSize: 8,
+        align: 4,
+        length: 2,
+        signature: 0n,
+        instance: {
+          members: [
+            { name: '0', type: MemberType.Float, bitSize: 32, byteSize: 4, bitOffset: 0, structure: {} },
+            { name: '1', type: MemberType.Object, bitSize: 8, byteSize: 1, bitOffset: 32, slot: 0, structure: packedStructure },
+          ],
+        },
+        static: {},
+      };
+      env.beginStructure(structure);
+      env.finishStructure(structure);
+      const { constructor: Tuple } = structure;
+      const tuple = new Tuple([ 1.5, { a: 5, b: true, c: -3 } ]);
+      expect(tuple.valueOf()).to.eql([ 1.5, { a: 5, b: true, c: -3 } ]);
+      expect(tuple.valueOf()).to.eql(normalizeObject(tuple, false, false));
+    })
+  })
 })